@@ -139,6 +139,21 @@ void
 randombytes_init(unsigned char *entropy_input,
                  unsigned char *personalization_string,
                  int security_strength)
+{
+    randombytes_init_ctx(&DRBG_ctx, entropy_input, personalization_string, security_strength);
+}
+
+int
+randombytes(unsigned char *x, unsigned long long xlen)
+{
+    return randombytes_ctx(&DRBG_ctx, x, xlen);
+}
+
+void
+randombytes_init_ctx(AES256_CTR_DRBG_struct *ctx,
+                     unsigned char *entropy_input,
+                     unsigned char *personalization_string,
+                     int security_strength)
 {
     unsigned char   seed_material[48];
     
@@ -146,14 +161,14 @@ randombytes_init(unsigned char *entropy_input,
     if (personalization_string)
         for (int i=0; i<48; i++)
             seed_material[i] ^= personalization_string[i];
-    memset(DRBG_ctx.Key, 0x00, 32);
-    memset(DRBG_ctx.V, 0x00, 16);
-    AES256_CTR_DRBG_Update(seed_material, DRBG_ctx.Key, DRBG_ctx.V);
-    DRBG_ctx.reseed_counter = 1;
+    memset(ctx->Key, 0x00, 32);
+    memset(ctx->V, 0x00, 16);
+    AES256_CTR_DRBG_Update(seed_material, ctx->Key, ctx->V);
+    ctx->reseed_counter = 1;
 }
 
 int
-randombytes(unsigned char *x, unsigned long long xlen)
+randombytes_ctx(AES256_CTR_DRBG_struct *ctx, unsigned char *x, unsigned long long xlen)
 {
     unsigned char   block[16];
     int             i = 0;
@@ -161,14 +176,14 @@ randombytes(unsigned char *x, unsigned long long xlen)
     while ( xlen > 0 ) {
         //increment V
         for (int j=15; j>=0; j--) {
-            if ( DRBG_ctx.V[j] == 0xff )
-                DRBG_ctx.V[j] = 0x00;
+            if ( ctx->V[j] == 0xff )
+                ctx->V[j] = 0x00;
             else {
-                DRBG_ctx.V[j]++;
+                ctx->V[j]++;
                 break;
             }
         }
-        AES256_ECB(DRBG_ctx.Key, DRBG_ctx.V, block);
+        AES256_ECB(ctx->Key, ctx->V, block);
         if ( xlen > 15 ) {
             memcpy(x+i, block, 16);
             i += 16;
@@ -179,8 +194,8 @@ randombytes(unsigned char *x, unsigned long long xlen)
             xlen = 0;
         }
     }
-    AES256_CTR_DRBG_Update(NULL, DRBG_ctx.Key, DRBG_ctx.V);
-    DRBG_ctx.reseed_counter++;
+    AES256_CTR_DRBG_Update(NULL, ctx->Key, ctx->V);
+    ctx->reseed_counter++;
     
     return RNG_SUCCESS;
 }
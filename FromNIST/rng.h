@@ -52,4 +52,14 @@ randombytes_init(unsigned char *entropy_input,
 int
 randombytes(unsigned char *x, unsigned long long xlen);
 
+// The same DRBG on a caller-owned state instead of the global one
+void
+randombytes_init_ctx(AES256_CTR_DRBG_struct *ctx,
+                     unsigned char *entropy_input,
+                     unsigned char *personalization_string,
+                     int security_strength);
+
+int
+randombytes_ctx(AES256_CTR_DRBG_struct *ctx, unsigned char *x, unsigned long long xlen);
+
 #endif /* rng_h */
@@ -36,6 +36,8 @@
  ******************************************************************************/
 
 #include "types.h"
+#include "conversions.h"
+#include "dispatch.h"
 
 //////////////////////////////////////////
 //      Conversion functions.
@@ -64,7 +66,7 @@ void convert2compact(OUT uint32_t out[DV], IN const uint8_t in[R_BITS])
 
 // convert a sequence of uint8_t elements which fully uses all 8-bits of an uint8_t element to
 // a sequence of uint8_t which uses just a single bit per byte (either 0 or 1).
-int convertByteToBinary(uint8_t* out, uint8_t * in, uint32_t length)
+int convertByteToBinary_portable(uint8_t* out, const uint8_t* in, uint32_t length)
 {
     uint32_t paddingLen = length % 8;
     uint32_t numBytes = (paddingLen == 0) ? (length / 8) : (1 + (length/8));
@@ -89,7 +91,7 @@ int convertByteToBinary(uint8_t* out, uint8_t * in, uint32_t length)
 
 // convert a sequence of uint8_t elements which uses just a single bit per byte (either 0 or 1) to
 // a sequence of uint8_t which fully uses all 8-bits of an uint8_t element.
-int convertBinaryToByte(uint8_t * out, const uint8_t* in, uint32_t length)
+int convertBinaryToByte_portable(uint8_t * out, const uint8_t* in, uint32_t length)
 {
     uint32_t paddingLen = length % 8;
     uint32_t numBytes = (paddingLen == 0) ? (length / 8) : (1 + (length/8));
@@ -111,3 +113,13 @@ int convertBinaryToByte(uint8_t * out, const uint8_t* in, uint32_t length)
     }
     return 0;
 }
+
+int convertByteToBinary(uint8_t* out, uint8_t * in, uint32_t length)
+{
+    return bike_dispatch()->byte_to_binary(out, in, length);
+}
+
+int convertBinaryToByte(uint8_t * out, const uint8_t* in, uint32_t length)
+{
+    return bike_dispatch()->binary_to_byte(out, in, length);
+}
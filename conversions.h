@@ -41,6 +41,19 @@
 
 int convertBinaryToByte(uint8_t* out, const uint8_t* in, uint32_t length);
 int convertByteToBinary(uint8_t* out, uint8_t * in,      uint32_t length);
+
+// Backends of the two conversions above, bound by dispatch.c. Both OR
+// into out, which the callers zero.
+typedef int (*conversion_t)(uint8_t* out, const uint8_t* in, uint32_t length);
+
+int convertBinaryToByte_portable(uint8_t* out, const uint8_t* in, uint32_t length);
+int convertByteToBinary_portable(uint8_t* out, const uint8_t* in, uint32_t length);
+
+#if !defined(BIKE_PORTABLE) && defined(__x86_64__)
+#define CONVERSIONS_HAVE_AVX2
+int convertBinaryToByte_avx2(uint8_t* out, const uint8_t* in, uint32_t length);
+int convertByteToBinary_avx2(uint8_t* out, const uint8_t* in, uint32_t length);
+#endif
 void convert2compact(OUT uint32_t out[DV], IN const uint8_t in[R_BITS]);
 
 #endif //_R_CONVERSIONS_H_
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "types.h"
+#include "conversions.h"
+
+#ifdef CONVERSIONS_HAVE_AVX2
+
+#include <string.h>
+#include <immintrin.h>
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+// 32 bits per step: each packed byte is broadcast to eight output bytes,
+// which then test one bit each.
+int convertByteToBinary_avx2(uint8_t* out, const uint8_t* in, uint32_t length)
+{
+    const __m256i spread = _mm256_setr_epi8(
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+            2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bits = _mm256_set1_epi64x(0x8040201008040201LL);
+    const __m256i one = _mm256_set1_epi8(1);
+    uint32_t i = 0;
+
+    for (; i + 32 <= length; i += 32)
+    {
+        uint32_t w;
+        memcpy(&w, in + i / 8, sizeof(w));
+
+        const __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32((int)w), spread);
+        const __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(v, bits), bits);
+        const __m256i o = _mm256_loadu_si256((const __m256i*)(out + i));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_or_si256(o, _mm256_and_si256(set, one)));
+    }
+
+    for (; i < length; i++)
+    {
+        if ((in[i / 8] >> (i % 8)) & 1)
+        {
+            out[i] = 1;
+        }
+    }
+    return 0;
+}
+
+// 32 bits per step: a byte compare against zero and a movemask.
+int convertBinaryToByte_avx2(uint8_t* out, const uint8_t* in, uint32_t length)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    uint32_t i = 0;
+
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(in + i));
+        uint32_t w, m = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+
+        memcpy(&w, out + i / 8, sizeof(w));
+        w |= m;
+        memcpy(out + i / 8, &w, sizeof(w));
+    }
+
+    for (; i < length; i++)
+    {
+        if (in[i])
+        {
+            out[i / 8] |= (uint8_t)(1 << (i % 8));
+        }
+    }
+    return 0;
+}
+
+#pragma GCC pop_options
+
+#endif //CONVERSIONS_HAVE_AVX2
@@ -36,16 +36,17 @@
  ******************************************************************************/
 
 #include "decode.h"
+#include "decode_trace.h"
+#include "dispatch.h"
 #include "utilities.h"
 
 #include "kem.h"
 #include "sampling.h"
 
-#include "ring_buffer.h"
+#include "threshold_tables.h"
 
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
 
 // count number of 1's in tmp:
 uint32_t getHammingWeight(const uint8_t tmp[R_BITS], const uint32_t length)
@@ -152,135 +153,296 @@ void flipAdjustedErrorPosition(uint8_t e[R_BITS*2], uint32_t position)
     e[adjustedPosition] ^= 1;
 }
 
-void BFMaskedIter(uint8_t e[R_BITS*2],
-    uint8_t s[R_BITS],
-    uint8_t mask[R_BITS*2],
-    uint32_t T,
-    uint32_t h0_compact[DV],
-    uint32_t h1_compact[DV],
-    uint32_t h0_compact_col[DV],
-    uint32_t h1_compact_col[DV])
+uint32_t bgf_threshold(IN const uint32_t syndrome_weight)
 {
+#if (BGF_THRESHOLD_RULE == THRESHOLD_EXACT)
+    return threshold_lookup(threshold_exact_runs,
+            THRESHOLD_RUNS(threshold_exact_runs), syndrome_weight);
+#else
+    return threshold_lookup(threshold_affine_runs,
+            THRESHOLD_RUNS(threshold_affine_runs), syndrome_weight);
+#endif
+}
 
-    uint8_t pos[R_BITS*2] = {0};
+// Byte-per-bit decoders (BIKE_LOW_MEM: decode_packed.c).
+#ifndef BIKE_LOW_MEM
 
-    for (uint32_t j = 0; j < R_BITS; j++)
-    {
-        uint32_t counter = ctr(h0_compact_col, j, s);
-        if (counter >= T && mask[j])
-        {
-            //e[j] ^= 1;
+#ifdef BIKE_DECODER_TRACE
+// The step of BGF_decoder_cfg_ws being run on this thread.
+static __thread bgf_trace_rec_t g_trace;
+static __thread uint32_t g_trace_decodes = 0;
+#endif
+
+// Flips the marked positions of e and updates the syndrome.
+_INLINE_ void flip_marked(uint8_t e[R_BITS*2],
+    uint8_t s[R_BITS],
+    const uint8_t marks[R_BITS*2],
+    uint32_t h0_compact[DV],
+    uint32_t h1_compact[DV])
+{
+#ifdef BIKE_DECODER_TRACE
+    // e first, then the syndrome, to time them apart (the updates do not
+    // read e, so the result is the same)
+    uint64_t t = bike_ticks();
+    for(uint32_t j=0; j < 2*R_BITS; j++){
+        if(marks[j] == 1){
             flipAdjustedErrorPosition(e, j);
-            pos[j] = 1;
+            g_trace.flips[j >= R_BITS]++;
         }
     }
+    g_trace.t_flip = bike_ticks() - t;
 
-    for (uint32_t j = 0; j < R_BITS; j++)
-    {
-        uint32_t counter = ctr(h1_compact_col, j, s);
-        if (counter >= T && mask[R_BITS+j])
-        {
-            //e[R_BITS+j] ^= 1;
-            flipAdjustedErrorPosition(e, R_BITS+j);
-            pos[R_BITS+j] = 1;
+    t = bike_ticks();
+    for(uint32_t j=0; j < 2*R_BITS; j++){
+        if(marks[j] == 1){
+            recompute_syndrome(s, j, h0_compact, h1_compact);
         }
     }
-
-    // flip bits at the end - as defined in the BGF decoder
+    g_trace.t_syndrome = bike_ticks() - t;
+#else
     for(uint32_t j=0; j < 2*R_BITS; j++){
-        if(pos[j] == 1){
+        if(marks[j] == 1){
+            flipAdjustedErrorPosition(e, j);
             recompute_syndrome(s, j, h0_compact, h1_compact);
         }
     }
+#endif
+}
+
+#ifdef BIKE_DECODER_TRACE
+// Starts the record of a step.
+_INLINE_ void trace_begin(IN const uint32_t iter,
+        IN const uint32_t kind,
+        IN const uint32_t syndrome_weight,
+        IN const uint32_t T)
+{
+    memset(&g_trace, 0, sizeof(g_trace));
+    g_trace.decode = g_trace_decodes;
+    g_trace.iter = iter;
+    g_trace.kind = kind;
+    g_trace.syndrome_weight = syndrome_weight;
+    g_trace.threshold = T;
+}
+
+// Number of marks per block.
+_INLINE_ void trace_count(OUT uint32_t count[2], IN const uint8_t marks[R_BITS*2])
+{
+    count[0] = getHammingWeight((uint8_t*)marks, R_BITS);
+    count[1] = getHammingWeight((uint8_t*)marks + R_BITS, R_BITS);
+}
+#endif
+
+void BFMaskedIter(uint8_t e[R_BITS*2],
+    uint8_t s[R_BITS],
+    uint8_t mask[R_BITS*2],
+    uint32_t T,
+    uint32_t h0_compact[DV],
+    uint32_t h1_compact[DV],
+    uint32_t h0_compact_col[DV],
+    uint32_t h1_compact_col[DV],
+    bike_ws_t* ws)
+{
+    uint8_t* pos = ws->pos;
+    const uint8_t T_ctr = ctr_threshold(T);
+    const bike_dispatch_t* d = bike_dispatch();
+#ifdef BIKE_DECODER_TRACE
+    const uint64_t t0 = bike_ticks();
+#endif
+
+    dup_syndrome(ws->s_dup, s);
+
+    d->upc_block(ws->upc, ws->s_dup, h0_compact_col, 0, R_PADDED_BITS);
+    d->threshold_masked_block(pos, ws->upc, mask, T_ctr, 0, R_BITS);
+
+    d->upc_block(ws->upc, ws->s_dup, h1_compact_col, 0, R_PADDED_BITS);
+    d->threshold_masked_block(pos + R_BITS, ws->upc, mask + R_BITS, T_ctr, 0, R_BITS);
+
+#ifdef BIKE_DECODER_TRACE
+    g_trace.t_counters = bike_ticks() - t0;
+#endif
+
+    // flip bits at the end - as defined in the BGF decoder
+    flip_marked(e, s, pos, h0_compact, h1_compact);
 }
 
 void BFIter(uint8_t e[R_BITS*2],
-    uint8_t black[R_BITS*2],
-    uint8_t gray[R_BITS*2],
     uint8_t s[R_BITS],
     uint32_t T,
+    uint32_t gray_gap,
     uint32_t h0_compact[DV],
     uint32_t h1_compact[DV],
     uint32_t h0_compact_col[DV],
-    uint32_t h1_compact_col[DV])
+    uint32_t h1_compact_col[DV],
+    bike_ws_t* ws)
 {
+    uint8_t* black = ws->black;
+    uint8_t* gray = ws->gray;
+    const uint8_t T_ctr = ctr_threshold(T);
+    // an empty gray range when T < gray_gap
+    const uint8_t T_gray = (T < gray_gap) ? T_ctr : ctr_threshold(T - gray_gap);
+    const bike_dispatch_t* d = bike_dispatch();
+#ifdef BIKE_DECODER_TRACE
+    const uint64_t t0 = bike_ticks();
+#endif
 
-    uint8_t pos[R_BITS*2] = {0};
+    dup_syndrome(ws->s_dup, s);
 
-    for (uint32_t j = 0; j < R_BITS; j++)
-    {
-        uint32_t counter = ctr(h0_compact_col, j, s);
-        if (counter >= T)
-        {
-            //e[j] ^= 1;
-            flipAdjustedErrorPosition(e, j);
-            pos[j] = 1;
-            black[j] = 1;
-        } else if(counter >= T - tau)
-        {
-            gray[j] = 1;
-        }
-    }
-    for (uint32_t j = 0; j < R_BITS; j++)
-    {
-        uint32_t counter = ctr(h1_compact_col, j, s);
+    d->upc_block(ws->upc, ws->s_dup, h0_compact_col, 0, R_PADDED_BITS);
+    d->threshold_block(black, gray, ws->upc, T_ctr, T_gray, 0, R_BITS);
 
-        if (counter >= T)
-        {
-            //e[R_BITS+j] ^= 1;
-            flipAdjustedErrorPosition(e, R_BITS+j);
-            pos[R_BITS+j] = 1;
-            black[R_BITS+j] = 1;
-        } else if(counter >= T - tau)
-            {
-                gray[R_BITS+j] = 1;
-            }
-    }
+    d->upc_block(ws->upc, ws->s_dup, h1_compact_col, 0, R_PADDED_BITS);
+    d->threshold_block(black + R_BITS, gray + R_BITS, ws->upc, T_ctr, T_gray, 0, R_BITS);
+
+#ifdef BIKE_DECODER_TRACE
+    g_trace.t_counters = bike_ticks() - t0;
+#endif
 
     // flip bits at the end
-    for(uint32_t j=0; j < 2*R_BITS; j++){
-        if(pos[j] == 1){
-            recompute_syndrome(s, j, h0_compact, h1_compact);
-        }
-    }
+    flip_marked(e, s, black, h0_compact, h1_compact);
+}
+
+void bgf_default_config(OUT bgf_config_t* cfg)
+{
+    cfg->n_iter = NbIter;
+    cfg->gray_gap = tau;
+    cfg->rule = BGF_THRESHOLD_RULE;
+    cfg->threshold_offset = 0;
+    cfg->masked_threshold = (DV+1)/2 + 1;
+}
+
+uint32_t bgf_config_threshold(IN const bgf_config_t* cfg,
+        IN const uint32_t syndrome_weight)
+{
+    const int64_t T = (int64_t)cfg->threshold_offset + ((cfg->rule == THRESHOLD_EXACT) ?
+            threshold_lookup(threshold_exact_runs, THRESHOLD_RUNS(threshold_exact_runs), syndrome_weight) :
+            threshold_lookup(threshold_affine_runs, THRESHOLD_RUNS(threshold_affine_runs), syndrome_weight));
+
+    return (T < 1) ? 1 : (uint32_t)T;
 }
 
 // Algorithm BGF - Black-Gray-Flip Decoder
-int BGF_decoder(uint8_t e[R_BITS*2],
+int BGF_decoder_cfg_ws(uint8_t e[R_BITS*2],
     uint8_t s[R_BITS],
     uint32_t h0_compact[DV],
-    uint32_t h1_compact[DV])
+    uint32_t h1_compact[DV],
+    const bgf_config_t* cfg,
+    bgf_stats_t* stats,
+    bike_ws_t* ws)
 {
+    bgf_config_t def;
+    if (cfg == NULL)
+    {
+        bgf_default_config(&def);
+        cfg = &def;
+    }
+
     memset(e, 0, R_BITS*2);
 
+    // stats has room for BGF_MAX_ITER iterations
+    if ((cfg->n_iter == 0) || (cfg->n_iter > BGF_MAX_ITER))
+    {
+        return 1; // FAILURE
+    }
+
     // computing the first column of each parity-check block:
     uint32_t h0_compact_col[DV] = {0};
     uint32_t h1_compact_col[DV] = {0};
     getCol(h0_compact_col, h0_compact);
     getCol(h1_compact_col, h1_compact);
 
-    uint8_t black[R_BITS*2] = {0};
-    uint8_t gray[R_BITS*2] = {0};
+#ifdef BIKE_DECODER_TRACE
+    const uint64_t t_start = bike_ticks();
+#endif
 
-    for (int i = 1; i <= NbIter; i++)
+    for (uint32_t i = 1; i <= cfg->n_iter; i++)
     {
-        memset(black, 0, R_BITS*2);
-        memset(gray, 0, R_BITS*2);
+        memset(ws->black, 0, R_BITS*2);
+        memset(ws->gray, 0, R_BITS*2);
+
+        const uint32_t weight = getHammingWeight(s, R_BITS);
+        if (stats != NULL)
+        {
+            stats->syndrome_weight[i - 1] = weight;
+        }
 
-        uint32_t T = floor(VAR_TH_FCT(getHammingWeight(s, R_BITS)));
+        uint32_t T = bgf_config_threshold(cfg, weight);
 
-        BFIter(e, black, gray, s, T, h0_compact, h1_compact, h0_compact_col, h1_compact_col);
+#ifdef BIKE_DECODER_TRACE
+        trace_begin(i, BGF_TRACE_ITER, weight, T);
+#endif
+        BFIter(e, s, T, cfg->gray_gap, h0_compact, h1_compact, h0_compact_col, h1_compact_col, ws);
+#ifdef BIKE_DECODER_TRACE
+        trace_count(g_trace.black, ws->black);
+        trace_count(g_trace.gray, ws->gray);
+        bgf_trace_emit(&g_trace);
+#endif
 
         if (i == 1)
         {
-            BFMaskedIter(e, s, black, (DV+1)/2 + 1, h0_compact, h1_compact, h0_compact_col, h1_compact_col);
-            BFMaskedIter(e, s, gray, (DV+1)/2 + 1, h0_compact, h1_compact, h0_compact_col, h1_compact_col);
+#ifdef BIKE_DECODER_TRACE
+            trace_begin(i, BGF_TRACE_MASKED_BLACK, getHammingWeight(s, R_BITS), cfg->masked_threshold);
+#endif
+            BFMaskedIter(e, s, ws->black, cfg->masked_threshold, h0_compact, h1_compact, h0_compact_col, h1_compact_col, ws);
+#ifdef BIKE_DECODER_TRACE
+            bgf_trace_emit(&g_trace);
+            trace_begin(i, BGF_TRACE_MASKED_GRAY, getHammingWeight(s, R_BITS), cfg->masked_threshold);
+#endif
+            BFMaskedIter(e, s, ws->gray, cfg->masked_threshold, h0_compact, h1_compact, h0_compact_col, h1_compact_col, ws);
+#ifdef BIKE_DECODER_TRACE
+            bgf_trace_emit(&g_trace);
+#endif
         }
     }
-    if (getHammingWeight(s, R_BITS) == 0)
+    const uint32_t weight = getHammingWeight(s, R_BITS);
+    if (stats != NULL)
+    {
+        stats->syndrome_weight[cfg->n_iter] = weight;
+    }
+
+#ifdef BIKE_DECODER_TRACE
+    trace_begin(cfg->n_iter, BGF_TRACE_END, weight, 0);
+    g_trace.t_total = bike_ticks() - t_start;
+    bgf_trace_emit(&g_trace);
+    g_trace_decodes++;
+#endif
+
+    if (weight == 0)
         return 0; // SUCCESS
     else
         return 1; // FAILURE
 }
 
+int BGF_decoder_stats_ws(uint8_t e[R_BITS*2],
+    uint8_t s[R_BITS],
+    uint32_t h0_compact[DV],
+    uint32_t h1_compact[DV],
+    bgf_stats_t* stats,
+    bike_ws_t* ws)
+{
+    return BGF_decoder_cfg_ws(e, s, h0_compact, h1_compact, NULL, stats, ws);
+}
+
+int BGF_decoder_ws(uint8_t e[R_BITS*2],
+    uint8_t s[R_BITS],
+    uint32_t h0_compact[DV],
+    uint32_t h1_compact[DV],
+    bike_ws_t* ws)
+{
+    return BGF_decoder_cfg_ws(e, s, h0_compact, h1_compact, NULL, NULL, ws);
+}
+
+int BGF_decoder(uint8_t e[R_BITS*2],
+    uint8_t s[R_BITS],
+    uint32_t h0_compact[DV],
+    uint32_t h1_compact[DV])
+{
+    bike_ws_t* ws = bike_ws_thread();
+    if (ws == NULL)
+    {
+        return 1; // FAILURE
+    }
+
+    return BGF_decoder_ws(e, s, h0_compact, h1_compact, ws);
+}
 
+#endif //BIKE_LOW_MEM
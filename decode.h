@@ -41,6 +41,7 @@
 
 #include "types.h"
 #include "conversions.h"
+#include "workspace.h"
 
 // transpose a row into a column:
 _INLINE_ void transpose(uint8_t col[R_BITS], uint8_t row[R_BITS])
@@ -55,9 +56,132 @@ _INLINE_ void transpose(uint8_t col[R_BITS], uint8_t row[R_BITS])
 // Count number of 1's in tmp:
 uint32_t getHammingWeight(const uint8_t tmp[R_BITS], const uint32_t length);
 
+// Function (not constant time) to check if an array is zero:
+uint32_t isZero(uint8_t s[R_BITS]);
+
+// Flip position pos (0..N_BITS-1) of the transposed syndrome indexing in
+// the syndrome, and in e:
+void recompute_syndrome(uint8_t s[R_BITS],
+        const uint32_t pos,
+        const uint32_t h0_compact[DV],
+        const uint32_t h1_compact[DV]);
+void flipAdjustedErrorPosition(uint8_t e[R_BITS*2], uint32_t position);
+
+// BGF threshold for a syndrome weight, under BGF_THRESHOLD_RULE (defs.h):
+uint32_t bgf_threshold(IN const uint32_t syndrome_weight);
+
+// Clamp a threshold to the byte range of the counters (they never exceed DV).
+_INLINE_ uint8_t ctr_threshold(IN const uint32_t T)
+{
+    return (T > UINT8_MAX) ? UINT8_MAX : (uint8_t)T;
+}
+
+// Compute the first column of a parity-check block from its first row:
+void getCol(uint32_t h_compact_col[DV],
+        uint32_t h_compact_row[DV]);
+
+#ifdef BIKE_LOW_MEM
+
+// Bit-packed BGF decoder (decode_packed.c): s is the syndrome c0*h0 in the
+// R_SIZE-byte polynomial format and e receives e0 || e1 as N_BITS packed
+// bits (the format of crypto_kem_dec's e'). Returns 0 on success.
+int BGF_decoder_packed_ws(OUT uint8_t e[N_SIZE],
+        IN OUT uint8_t s[R_SIZE],
+        IN const uint32_t h0_compact[DV],
+        IN const uint32_t h1_compact[DV],
+        IN OUT bike_ws_t* ws);
+
+#else
+
+// Runtime parameters of BGF_decoder_cfg_ws (decoder tuning). The compiled
+// decoder uses bgf_default_config: NbIter, tau, BGF_THRESHOLD_RULE with no
+// offset and (DV+1)/2 + 1 in the masked iterations.
+#define BGF_MAX_ITER 16U
+
+#if (NbIter < 1) || (NbIter > BGF_MAX_ITER)
+#error "NbIter must be between 1 and BGF_MAX_ITER"
+#endif
+
+typedef struct bgf_config_s
+{
+    // iterations, 1..BGF_MAX_ITER
+    uint32_t n_iter;
+    // width of the gray range below the threshold (tau)
+    uint32_t gray_gap;
+    // THRESHOLD_AFFINE or THRESHOLD_EXACT, plus a constant offset
+    uint32_t rule;
+    int32_t threshold_offset;
+    // threshold of the two masked iterations after the first one
+    uint32_t masked_threshold;
+} bgf_config_t;
+
+void bgf_default_config(OUT bgf_config_t* cfg);
+
+// Threshold of a rule of bgf_config_t for a syndrome weight (at least 1).
+uint32_t bgf_config_threshold(IN const bgf_config_t* cfg,
+        IN const uint32_t syndrome_weight);
+
+// Syndrome weight before each BGF iteration; entry n_iter is the weight
+// left after the last iteration (0 on success).
+typedef struct bgf_stats_s
+{
+    uint32_t syndrome_weight[BGF_MAX_ITER + 1];
+} bgf_stats_t;
+
+// The decoders keep their temporaries in ws; the variants without _ws use
+// the thread workspace and fail (return 1) if it cannot be allocated.
+// BGF_decoder_cfg_ws runs with cfg (the default one when NULL) and fills
+// stats when not NULL; BGF_decoder_stats_ws uses the default config. A cfg
+// whose n_iter is not in 1..BGF_MAX_ITER is rejected: the decoder returns
+// 1 with e cleared, and leaves s and stats untouched.
+int BGF_decoder_cfg_ws(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        IN const bgf_config_t* cfg,
+        OUT bgf_stats_t* stats,
+        bike_ws_t* ws);
+
+int BGF_decoder_stats_ws(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        OUT bgf_stats_t* stats,
+        bike_ws_t* ws);
+
+int BGF_decoder_ws(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        bike_ws_t* ws);
+
 int BGF_decoder(uint8_t e[R_BITS*2],
         uint8_t s[R_BITS],
         uint32_t h0_compact[DV],
         uint32_t h1_compact[DV]);
 
+// Backflip decoder (Sendrier-Vasseur): every flip gets a time to live
+// (backflip_ttl) and is undone when it expires, with the exact threshold of
+// compute_threshold (tabulated, threshold_table_t). Same interface and return value as BGF_decoder; runs
+// at most max_iter iterations (backflip_decoder: BACKFLIP_NB_ITER).
+int backflip_decoder_iter(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        IN const uint32_t max_iter,
+        bike_ws_t* ws);
+
+int backflip_decoder_ws(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        bike_ws_t* ws);
+
+int backflip_decoder(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV]);
+
+#endif //BIKE_LOW_MEM
+
 #endif //_R_DECAPS_H_
@@ -0,0 +1,188 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "decode.h"
+#include "dispatch.h"
+#include "flip_queue.h"
+#include "threshold.h"
+
+#include <string.h>
+#include <pthread.h>
+
+#ifndef BIKE_LOW_MEM
+
+// compute_threshold(R_BITS, N_BITS, DV, 2*DV, S, t) for the remaining
+// errors t = 1..T1, with its lgamma terms tabulated once per process.
+static double g_bf_lnbino[DV + 1];
+static double g_bf_iks[T1 + 1];
+static threshold_table_t g_bf_threshold;
+static pthread_once_t g_bf_threshold_once = PTHREAD_ONCE_INIT;
+
+static void backflip_threshold_init(void)
+{
+    threshold_table_init(&g_bf_threshold, R_BITS, N_BITS, DV, 2*DV, T1,
+            g_bf_lnbino, g_bf_iks);
+}
+
+// Time to live of a flip whose counter is delta above the threshold.
+_INLINE_ uint8_t backflip_ttl(IN const uint32_t delta)
+{
+    const uint32_t ttl = (45*delta + 110) / 100;
+    if (ttl > BACKFLIP_MAX_TTL)
+    {
+        return BACKFLIP_MAX_TTL;
+    }
+    return (ttl < 1) ? 1 : (uint8_t)ttl;
+}
+
+_INLINE_ void flip_position(IN OUT uint8_t e[R_BITS*2],
+        IN OUT uint8_t s[R_BITS],
+        IN const uint32_t j,
+        IN const uint32_t h0_compact[DV],
+        IN const uint32_t h1_compact[DV])
+{
+    flipAdjustedErrorPosition(e, j);
+    recompute_syndrome(s, j, h0_compact, h1_compact);
+}
+
+int backflip_decoder_iter(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        IN const uint32_t max_iter,
+        bike_ws_t* ws)
+{
+    memset(e, 0, R_BITS*2);
+    pthread_once(&g_bf_threshold_once, backflip_threshold_init);
+
+    uint32_t h_compact_col[2][DV] = {{0}};
+    getCol(h_compact_col[0], h0_compact);
+    getCol(h_compact_col[1], h1_compact);
+
+    // pending flips by expiry iteration; a position is flipped iff queued
+    if (ws->fq == NULL)
+    {
+        ws->fq = fq_alloc();
+        if (ws->fq == NULL)
+        {
+            return 1; // FAILURE
+        }
+    }
+    flip_queue_t* q = ws->fq;
+    fq_reset(q);
+
+    const bike_dispatch_t* d = bike_dispatch();
+    uint8_t* s_dup = ws->s_dup;
+    uint8_t* upc = ws->upc;
+    // ttl[j] != 0: flip position j with that time to live
+    uint8_t* ttl = ws->pos;
+
+    for (uint32_t it = 1; (it <= max_iter) && !isZero(s); it++)
+    {
+        // undo the flips whose time to live has expired
+        for (uint32_t j = fq_pop_expired(q, it); j != FQ_NIL; j = fq_pop_expired(q, it))
+        {
+            flip_position(e, s, j, h0_compact, h1_compact);
+        }
+
+        // exact threshold for the remaining errors t - |e|
+        const uint32_t S = getHammingWeight(s, R_BITS);
+        const uint32_t t_left = (T1 > q->length) ? (uint32_t)(T1 - q->length) : 1;
+        const uint32_t T = (uint32_t)threshold_table_compute(&g_bf_threshold, S, t_left);
+
+        dup_syndrome(s_dup, s);
+        for (uint32_t b = 0; b < 2; b++)
+        {
+            d->upc_block(upc, s_dup, h_compact_col[b], 0, R_PADDED_BITS);
+            for (uint32_t j = 0; j < R_BITS; j++)
+            {
+                ttl[b*R_BITS + j] = (upc[j] >= T) ? backflip_ttl(upc[j] - T) : 0;
+            }
+        }
+
+        // flip at the end of the sweep; flipping a queued position back
+        // cancels its entry
+        for (uint32_t j = 0; j < R_BITS*2; j++)
+        {
+            if (ttl[j] == 0)
+            {
+                continue;
+            }
+
+            flip_position(e, s, j, h0_compact, h1_compact);
+            if (fq_contains(q, j))
+            {
+                fq_remove(q, j);
+            }
+            else if (fq_insert(q, j, it + ttl[j]) != 0)
+            {
+                // far more flips pending than errors: give up
+                return 1; // FAILURE
+            }
+        }
+    }
+
+    if (isZero(s))
+        return 0; // SUCCESS
+    else
+        return 1; // FAILURE
+}
+
+int backflip_decoder_ws(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        bike_ws_t* ws)
+{
+    return backflip_decoder_iter(e, s, h0_compact, h1_compact, BACKFLIP_NB_ITER, ws);
+}
+
+int backflip_decoder(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV])
+{
+    bike_ws_t* ws = bike_ws_thread();
+    if (ws == NULL)
+    {
+        return 1; // FAILURE
+    }
+
+    return backflip_decoder_ws(e, s, h0_compact, h1_compact, ws);
+}
+
+#endif //BIKE_LOW_MEM
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "decode_kernels.h"
+
+#include <string.h>
+
+void dup_syndrome(OUT uint8_t s_dup[S_DUP_SIZE], IN const uint8_t s[R_BITS])
+{
+    memcpy(s_dup, s, R_BITS);
+    memcpy(s_dup + R_BITS, s, R_BITS);
+    memset(s_dup + 2*R_BITS, 0, UPC_PAD);
+}
+
+// Portable kernels; the inner loops are contiguous so the compiler can
+// vectorize them for the target.
+void upc_block_portable(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = first + count;
+    uint32_t t = first;
+
+    // Tiles of UPC_TILE counters (defs.h): the tile stays in registers or
+    // L1 while the DV column windows of the syndrome are added to it.
+    for (; t + UPC_TILE <= end; t += UPC_TILE)
+    {
+        uint8_t acc[UPC_TILE] = {0};
+
+        for (uint32_t i = 0; i < DV; i++)
+        {
+            const uint8_t* row = s_dup + h_compact_col[i] + t;
+#pragma GCC unroll 256
+            for (uint32_t j = 0; j < UPC_TILE; j++)
+            {
+                acc[j] += row[j];
+            }
+        }
+        memcpy(upc + t, acc, UPC_TILE);
+    }
+
+    // the rest of the range, UPC_PAD at a time
+    for (; t < end; t += UPC_PAD)
+    {
+        uint8_t acc[UPC_PAD] = {0};
+
+        for (uint32_t i = 0; i < DV; i++)
+        {
+            const uint8_t* row = s_dup + h_compact_col[i] + t;
+#pragma GCC unroll 64
+            for (uint32_t j = 0; j < UPC_PAD; j++)
+            {
+                acc[j] += row[j];
+            }
+        }
+        memcpy(upc + t, acc, UPC_PAD);
+    }
+}
+
+void threshold_block_portable(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = THRESHOLD_END(first, count);
+
+    for (uint32_t j = first; j < end; j++)
+    {
+        black[j] = (upc[j] >= T);
+        gray[j] = (upc[j] >= T_gray) & (upc[j] < T);
+    }
+}
+
+void threshold_masked_block_portable(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = THRESHOLD_END(first, count);
+
+    for (uint32_t j = first; j < end; j++)
+    {
+        flip[j] = (upc[j] >= T) & mask[j];
+    }
+}
@@ -0,0 +1,204 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _DECODE_KERNELS_H_
+#define _DECODE_KERNELS_H_
+
+#include "types.h"
+
+// Vector kernels of the BGF counter phase. The counters of a whole block
+// are computed at once: with the syndrome concatenated to itself, the bits
+// selected by column offset c for positions j..j+W-1 are the contiguous
+// bytes s_dup[c+j .. c+j+W), so every h-column index becomes one unaligned
+// vector load that is accumulated with byte adds (counters are at most DV).
+
+// The SIMD kernels are compiled for their instruction set regardless of
+// CFLAGS; dispatch.c binds the ones the CPU supports.
+
+// Buffers are padded to whole vectors of the widest kernel.
+#define UPC_PAD 64ULL
+#define R_PADDED_BITS (DIVIDE_AND_CEIL(R_BITS, UPC_PAD) * UPC_PAD)
+#define S_DUP_SIZE (2*R_BITS + UPC_PAD)
+
+#if (UPC_TILE == 0) || ((UPC_TILE % UPC_PAD) != 0)
+#error "UPC_TILE must be a nonzero multiple of UPC_PAD"
+#endif
+
+// s_dup = s || s || 0.
+void dup_syndrome(OUT uint8_t s_dup[S_DUP_SIZE], IN const uint8_t s[R_BITS]);
+
+// The kernels work on the positions first <= j < first + count of a block
+// (a whole block: 0, R_PADDED_BITS), so that a block can be split among
+// threads. first and count are multiples of UPC_PAD; the threshold kernels
+// stop at R_BITS.
+#define THRESHOLD_END(first, count) (((first) + (count) < R_BITS) ? ((first) + (count)) : R_BITS)
+
+// upc[j] = sum_i s[(h_compact_col[i] + j) % R_BITS] for j < R_BITS.
+typedef void (*upc_block_t)(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count);
+
+// black[j] = (upc[j] >= T), gray[j] = (T_gray <= upc[j] < T), for j < R_BITS.
+typedef void (*threshold_block_t)(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count);
+
+// flip[j] = (upc[j] >= T) & mask[j], for j < R_BITS.
+typedef void (*threshold_masked_block_t)(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count);
+
+void upc_block_portable(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count);
+void threshold_block_portable(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count);
+void threshold_masked_block_portable(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count);
+
+// Experimental NTT counter engine (UPC_ENGINE_NTT, defs.h): the counters of
+// a whole block as one integer convolution, with O(r log r) cost instead of
+// O(DV r). ntt_ctr_t holds the transform buffers for one r (any r up to
+// 2^22, dv up to NTT_CTR_MAX_DV); ntt_ctr_alloc returns NULL on failure.
+// ntt_ctr_compute writes upc[j] for j < r from s[0..r) and the dv column
+// offsets. upc_block_ntt uses a context per thread and computes the whole
+// block for any range.
+#define NTT_CTR_MAX_DV 255U
+
+typedef struct ntt_ctr_s ntt_ctr_t;
+
+ntt_ctr_t* ntt_ctr_alloc(IN const uint32_t r);
+void ntt_ctr_free(IN ntt_ctr_t* ctx);
+void ntt_ctr_compute(OUT uint8_t* upc,
+        IN const uint8_t* s,
+        IN const uint32_t* h_compact_col,
+        IN const uint32_t dv,
+        IN OUT ntt_ctr_t* ctx);
+
+void upc_block_ntt(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count);
+
+#if !defined(BIKE_PORTABLE) && defined(__x86_64__)
+#define DECODE_HAVE_AVX2
+void upc_block_avx2(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count);
+void threshold_block_avx2(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count);
+void threshold_masked_block_avx2(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count);
+#endif
+
+#if !defined(BIKE_PORTABLE) && defined(__x86_64__)
+#define DECODE_HAVE_AVX512
+void upc_block_avx512(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count);
+void threshold_block_avx512(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count);
+void threshold_masked_block_avx512(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count);
+#endif
+
+#if !defined(BIKE_PORTABLE) && (defined(__arm__) || defined(__aarch64__) || defined(__ARM_NEON))
+#define DECODE_HAVE_NEON
+void upc_block_neon(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count);
+void threshold_block_neon(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count);
+void threshold_masked_block_neon(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count);
+#endif
+
+#endif //_DECODE_KERNELS_H_
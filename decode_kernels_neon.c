@@ -0,0 +1,134 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "decode_kernels.h"
+
+#ifdef DECODE_HAVE_NEON
+
+// An ARMv7 build for cores without NEON still carries this code.
+#pragma GCC push_options
+#if defined(__arm__) && !defined(__ARM_NEON__)
+#pragma GCC target("fpu=neon")
+#endif
+
+#include <arm_neon.h>
+
+void upc_block_neon(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    // four q-register accumulators (64 positions) per pass over the columns
+    for (uint32_t j = first; j < first + count; j += 64)
+    {
+        uint8x16_t acc0 = vdupq_n_u8(0);
+        uint8x16_t acc1 = vdupq_n_u8(0);
+        uint8x16_t acc2 = vdupq_n_u8(0);
+        uint8x16_t acc3 = vdupq_n_u8(0);
+
+        for (uint32_t i = 0; i < DV; i++)
+        {
+            const uint8_t* row = s_dup + h_compact_col[i] + j;
+            acc0 = vqaddq_u8(acc0, vld1q_u8(row));
+            acc1 = vqaddq_u8(acc1, vld1q_u8(row + 16));
+            acc2 = vqaddq_u8(acc2, vld1q_u8(row + 32));
+            acc3 = vqaddq_u8(acc3, vld1q_u8(row + 48));
+        }
+        vst1q_u8(upc + j, acc0);
+        vst1q_u8(upc + j + 16, acc1);
+        vst1q_u8(upc + j + 32, acc2);
+        vst1q_u8(upc + j + 48, acc3);
+    }
+}
+
+void threshold_block_neon(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = THRESHOLD_END(first, count);
+    const uint8x16_t vT = vdupq_n_u8(T);
+    const uint8x16_t vT_gray = vdupq_n_u8(T_gray);
+    const uint8x16_t one = vdupq_n_u8(1);
+    uint32_t j = first;
+
+    for (; j + 16 <= end; j += 16)
+    {
+        const uint8x16_t c = vld1q_u8(upc + j);
+        const uint8x16_t b = vcgeq_u8(c, vT);
+        const uint8x16_t g = vbicq_u8(vcgeq_u8(c, vT_gray), b);
+        vst1q_u8(black + j, vandq_u8(b, one));
+        vst1q_u8(gray + j, vandq_u8(g, one));
+    }
+
+    for (; j < end; j++)
+    {
+        black[j] = (upc[j] >= T);
+        gray[j] = (upc[j] >= T_gray) & (upc[j] < T);
+    }
+}
+
+void threshold_masked_block_neon(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = THRESHOLD_END(first, count);
+    const uint8x16_t vT = vdupq_n_u8(T);
+    uint32_t j = first;
+
+    for (; j + 16 <= end; j += 16)
+    {
+        const uint8x16_t c = vld1q_u8(upc + j);
+        vst1q_u8(flip + j, vandq_u8(vcgeq_u8(c, vT), vld1q_u8(mask + j)));
+    }
+
+    for (; j < end; j++)
+    {
+        flip[j] = (upc[j] >= T) & mask[j];
+    }
+}
+
+#pragma GCC pop_options
+
+#endif //DECODE_HAVE_NEON
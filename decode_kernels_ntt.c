@@ -0,0 +1,342 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "decode_kernels.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Counters as an integer convolution: with g[(r - c) % r] = 1 for every
+// column offset c, upc = s * g cyclically. Both are zero-padded to a
+// power of two n >= 2r, so the NTT product is the linear convolution, and
+// the cyclic one is folded back from it: upc[j] = lin[j] + lin[j + r].
+// The counters never exceed dv, so the result mod NTT_P is exact.
+
+#define NTT_P 998244353U // 119 * 2^23 + 1
+#define NTT_G 3U
+#define NTT_MAX_LOG 23U
+
+struct ntt_ctr_s
+{
+    uint32_t r;
+    uint32_t len;
+    uint32_t len_inv;
+    // powers of the forward and inverse len-th roots of unity (len/2 each)
+    uint32_t* roots;
+    uint32_t* iroots;
+    // transform of the syndrome, then of the product
+    uint32_t* a;
+    // counters of the last block computed by upc_block_ntt
+    uint8_t* upc;
+    // transforms of the last two column sets (h0 and h1 alternate)
+    uint32_t* g_hat[2];
+    uint32_t g_col[2][NTT_CTR_MAX_DV];
+    uint32_t g_dv[2];
+    uint32_t g_next;
+};
+
+_INLINE_ uint32_t ntt_mul(IN const uint32_t a, IN const uint32_t b)
+{
+    return (uint32_t)(((uint64_t)a * b) % NTT_P);
+}
+
+// Branch-free: the transform data is random, so a conditional subtraction
+// mispredicts half of the time. An out-of-range result wraps above 2^32 - P.
+_INLINE_ uint32_t ntt_add(IN const uint32_t a, IN const uint32_t b)
+{
+    const uint32_t s = a + b;
+    const uint32_t t = s - NTT_P;
+    return (t < s) ? t : s;
+}
+
+_INLINE_ uint32_t ntt_sub(IN const uint32_t a, IN const uint32_t b)
+{
+    const uint32_t d = a - b;
+    const uint32_t t = d + NTT_P;
+    return (d < t) ? d : t;
+}
+
+static uint32_t ntt_pow(IN uint32_t a, IN uint32_t e)
+{
+    uint32_t res = 1;
+    for (; e; e >>= 1)
+    {
+        if (e & 1)
+        {
+            res = ntt_mul(res, a);
+        }
+        a = ntt_mul(a, a);
+    }
+    return res;
+}
+
+// In-place iterative radix-2 transform with the given root powers.
+static void ntt_transform(IN OUT uint32_t* a,
+        IN const uint32_t n,
+        IN const uint32_t* roots)
+{
+    for (uint32_t i = 1, j = 0; i < n; i++)
+    {
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j)
+        {
+            const uint32_t t = a[i];
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        const uint32_t half = len >> 1;
+        const uint32_t step = n / len;
+
+        for (uint32_t i = 0; i < n; i += len)
+        {
+            for (uint32_t k = 0; k < half; k++)
+            {
+                const uint32_t u = a[i + k];
+                const uint32_t v = ntt_mul(a[i + k + half], roots[k * step]);
+                a[i + k] = ntt_add(u, v);
+                a[i + k + half] = ntt_sub(u, v);
+            }
+        }
+    }
+}
+
+ntt_ctr_t* ntt_ctr_alloc(IN const uint32_t r)
+{
+    uint32_t log_len = 0;
+    while ((1ULL << log_len) < 2ULL * r)
+    {
+        log_len++;
+    }
+    if ((r == 0) || (log_len > NTT_MAX_LOG))
+    {
+        return NULL;
+    }
+
+    ntt_ctr_t* ctx = (ntt_ctr_t*)calloc(1, sizeof(ntt_ctr_t));
+    if (ctx == NULL)
+    {
+        return NULL;
+    }
+
+    const uint32_t n = 1U << log_len;
+    ctx->r = r;
+    ctx->len = n;
+    ctx->len_inv = ntt_pow(n, NTT_P - 2);
+    ctx->roots = (uint32_t*)malloc((n / 2) * sizeof(uint32_t));
+    ctx->iroots = (uint32_t*)malloc((n / 2) * sizeof(uint32_t));
+    ctx->a = (uint32_t*)malloc(n * sizeof(uint32_t));
+    ctx->upc = (uint8_t*)malloc(r);
+    ctx->g_hat[0] = (uint32_t*)malloc(n * sizeof(uint32_t));
+    ctx->g_hat[1] = (uint32_t*)malloc(n * sizeof(uint32_t));
+
+    if ((ctx->roots == NULL) || (ctx->iroots == NULL) || (ctx->a == NULL) || (ctx->upc == NULL) ||
+        (ctx->g_hat[0] == NULL) || (ctx->g_hat[1] == NULL))
+    {
+        ntt_ctr_free(ctx);
+        return NULL;
+    }
+
+    const uint32_t w = ntt_pow(NTT_G, (NTT_P - 1) >> log_len);
+    const uint32_t w_inv = ntt_pow(w, NTT_P - 2);
+    ctx->roots[0] = 1;
+    ctx->iroots[0] = 1;
+    for (uint32_t k = 1; k < n / 2; k++)
+    {
+        ctx->roots[k] = ntt_mul(ctx->roots[k - 1], w);
+        ctx->iroots[k] = ntt_mul(ctx->iroots[k - 1], w_inv);
+    }
+
+    return ctx;
+}
+
+void ntt_ctr_free(IN ntt_ctr_t* ctx)
+{
+    if (ctx == NULL)
+    {
+        return;
+    }
+
+    free(ctx->roots);
+    free(ctx->iroots);
+    free(ctx->a);
+    free(ctx->upc);
+    free(ctx->g_hat[0]);
+    free(ctx->g_hat[1]);
+    free(ctx);
+}
+
+// Transform of the column indicator g, from the cache when possible.
+static const uint32_t* ntt_columns(IN OUT ntt_ctr_t* ctx,
+        IN const uint32_t* h_compact_col,
+        IN const uint32_t dv)
+{
+    for (uint32_t c = 0; c < 2; c++)
+    {
+        if ((ctx->g_dv[c] == dv) &&
+            (memcmp(ctx->g_col[c], h_compact_col, dv * sizeof(uint32_t)) == 0))
+        {
+            return ctx->g_hat[c];
+        }
+    }
+
+    const uint32_t c = ctx->g_next;
+    uint32_t* g = ctx->g_hat[c];
+    ctx->g_next ^= 1;
+
+    memset(g, 0, ctx->len * sizeof(uint32_t));
+    for (uint32_t i = 0; i < dv; i++)
+    {
+        g[(ctx->r - h_compact_col[i]) % ctx->r] = 1;
+    }
+    ntt_transform(g, ctx->len, ctx->roots);
+
+    memcpy(ctx->g_col[c], h_compact_col, dv * sizeof(uint32_t));
+    ctx->g_dv[c] = dv;
+
+    return g;
+}
+
+void ntt_ctr_compute(OUT uint8_t* upc,
+        IN const uint8_t* s,
+        IN const uint32_t* h_compact_col,
+        IN const uint32_t dv,
+        IN OUT ntt_ctr_t* ctx)
+{
+    const uint32_t r = ctx->r;
+    const uint32_t n = ctx->len;
+    const uint32_t* g_hat = ntt_columns(ctx, h_compact_col, dv);
+    uint32_t* a = ctx->a;
+
+    for (uint32_t i = 0; i < r; i++)
+    {
+        a[i] = s[i];
+    }
+    memset(a + r, 0, (n - r) * sizeof(uint32_t));
+
+    ntt_transform(a, n, ctx->roots);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        a[i] = ntt_mul(a[i], g_hat[i]);
+    }
+    ntt_transform(a, n, ctx->iroots);
+
+    // n >= 2r: a[j + r] is in range, and the sum is below 2^32
+    for (uint32_t j = 0; j < r; j++)
+    {
+        upc[j] = (uint8_t)ntt_mul(a[j] + a[j + r], ctx->len_inv);
+    }
+}
+
+// Every thread using the kernel keeps a context for R_BITS (up to about
+// 40 * R_BITS bytes), freed at thread exit.
+static pthread_key_t g_ntt_key;
+static pthread_once_t g_ntt_once = PTHREAD_ONCE_INIT;
+static int g_ntt_key_ok = 0;
+
+static void ntt_key_destroy(IN void* ctx)
+{
+    ntt_ctr_free((ntt_ctr_t*)ctx);
+}
+
+static void ntt_key_create(void)
+{
+    g_ntt_key_ok = (pthread_key_create(&g_ntt_key, ntt_key_destroy) == 0);
+}
+
+static ntt_ctr_t* ntt_ctr_thread(void)
+{
+    pthread_once(&g_ntt_once, ntt_key_create);
+    if (!g_ntt_key_ok)
+    {
+        return NULL;
+    }
+
+    ntt_ctr_t* ctx = (ntt_ctr_t*)pthread_getspecific(g_ntt_key);
+    if (ctx != NULL)
+    {
+        return ctx;
+    }
+
+    ctx = ntt_ctr_alloc(R_BITS);
+    if ((ctx != NULL) && (pthread_setspecific(g_ntt_key, ctx) != 0))
+    {
+        ntt_ctr_free(ctx);
+        ctx = NULL;
+    }
+
+    return ctx;
+}
+
+void upc_block_ntt(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    ntt_ctr_t* ctx = ntt_ctr_thread();
+    if (ctx == NULL)
+    {
+        // kernels cannot fail
+        upc_block_portable(upc, s_dup, h_compact_col, first, count);
+        return;
+    }
+
+    // the whole block, then the requested range (the padding reads 0)
+    ntt_ctr_compute(ctx->upc, s_dup, h_compact_col, DV, ctx);
+
+    const uint32_t end = THRESHOLD_END(first, count);
+    if (end > first)
+    {
+        memcpy(upc + first, ctx->upc + first, end - first);
+        memset(upc + end, 0, first + count - end);
+    }
+    else
+    {
+        memset(upc + first, 0, count);
+    }
+}
@@ -0,0 +1,261 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "decode_kernels.h"
+
+#ifdef DECODE_HAVE_AVX2
+
+#include <immintrin.h>
+
+// Unsigned byte compares (counters may exceed 127): a >= b <=> max(a, b) == a.
+#define GE_EPU8_256(a, b) _mm256_cmpeq_epi8(_mm256_max_epu8((a), (b)), (a))
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+void upc_block_avx2(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = first + count;
+
+    // four accumulators (128 positions) per pass over the column indices
+    for (uint32_t j = first; j < end; j += 128)
+    {
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        __m256i acc2 = _mm256_setzero_si256();
+        __m256i acc3 = _mm256_setzero_si256();
+
+        if (j + 128 > end)
+        {
+            // last 64 positions
+            for (uint32_t i = 0; i < DV; i++)
+            {
+                const uint8_t* row = s_dup + h_compact_col[i] + j;
+                acc0 = _mm256_add_epi8(acc0, _mm256_loadu_si256((const __m256i*)row));
+                acc1 = _mm256_add_epi8(acc1, _mm256_loadu_si256((const __m256i*)(row + 32)));
+            }
+            _mm256_storeu_si256((__m256i*)(upc + j), acc0);
+            _mm256_storeu_si256((__m256i*)(upc + j + 32), acc1);
+            break;
+        }
+
+        for (uint32_t i = 0; i < DV; i++)
+        {
+            const uint8_t* row = s_dup + h_compact_col[i] + j;
+            acc0 = _mm256_add_epi8(acc0, _mm256_loadu_si256((const __m256i*)row));
+            acc1 = _mm256_add_epi8(acc1, _mm256_loadu_si256((const __m256i*)(row + 32)));
+            acc2 = _mm256_add_epi8(acc2, _mm256_loadu_si256((const __m256i*)(row + 64)));
+            acc3 = _mm256_add_epi8(acc3, _mm256_loadu_si256((const __m256i*)(row + 96)));
+        }
+        _mm256_storeu_si256((__m256i*)(upc + j), acc0);
+        _mm256_storeu_si256((__m256i*)(upc + j + 32), acc1);
+        _mm256_storeu_si256((__m256i*)(upc + j + 64), acc2);
+        _mm256_storeu_si256((__m256i*)(upc + j + 96), acc3);
+    }
+}
+
+void threshold_block_avx2(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = THRESHOLD_END(first, count);
+    const __m256i vT = _mm256_set1_epi8((char)T);
+    const __m256i vT_gray = _mm256_set1_epi8((char)T_gray);
+    const __m256i one = _mm256_set1_epi8(1);
+    uint32_t j = first;
+
+    for (; j + 32 <= end; j += 32)
+    {
+        const __m256i c = _mm256_loadu_si256((const __m256i*)(upc + j));
+        const __m256i b = GE_EPU8_256(c, vT);
+        const __m256i g = _mm256_andnot_si256(b, GE_EPU8_256(c, vT_gray));
+        _mm256_storeu_si256((__m256i*)(black + j), _mm256_and_si256(b, one));
+        _mm256_storeu_si256((__m256i*)(gray + j), _mm256_and_si256(g, one));
+    }
+
+    for (; j < end; j++)
+    {
+        black[j] = (upc[j] >= T);
+        gray[j] = (upc[j] >= T_gray) & (upc[j] < T);
+    }
+}
+
+void threshold_masked_block_avx2(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = THRESHOLD_END(first, count);
+    const __m256i vT = _mm256_set1_epi8((char)T);
+    uint32_t j = first;
+
+    for (; j + 32 <= end; j += 32)
+    {
+        const __m256i c = _mm256_loadu_si256((const __m256i*)(upc + j));
+        const __m256i m = _mm256_loadu_si256((const __m256i*)(mask + j));
+        _mm256_storeu_si256((__m256i*)(flip + j), _mm256_and_si256(GE_EPU8_256(c, vT), m));
+    }
+
+    for (; j < end; j++)
+    {
+        flip[j] = (upc[j] >= T) & mask[j];
+    }
+}
+
+#pragma GCC pop_options
+
+#endif //DECODE_HAVE_AVX2
+
+#ifdef DECODE_HAVE_AVX512
+
+#pragma GCC push_options
+#pragma GCC target("avx2,avx512f,avx512bw")
+
+void upc_block_avx512(OUT uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t s_dup[S_DUP_SIZE],
+        IN const uint32_t h_compact_col[DV],
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = first + count;
+
+    // count is a multiple of 64: two accumulators, then a tail of one
+    uint32_t j = first;
+
+    for (; j + 128 <= end; j += 128)
+    {
+        __m512i acc0 = _mm512_setzero_si512();
+        __m512i acc1 = _mm512_setzero_si512();
+
+        for (uint32_t i = 0; i < DV; i++)
+        {
+            const uint8_t* row = s_dup + h_compact_col[i] + j;
+            acc0 = _mm512_add_epi8(acc0, _mm512_loadu_si512((const void*)row));
+            acc1 = _mm512_add_epi8(acc1, _mm512_loadu_si512((const void*)(row + 64)));
+        }
+        _mm512_storeu_si512((void*)(upc + j), acc0);
+        _mm512_storeu_si512((void*)(upc + j + 64), acc1);
+    }
+
+    if (j < end)
+    {
+        __m512i acc = _mm512_setzero_si512();
+        for (uint32_t i = 0; i < DV; i++)
+        {
+            acc = _mm512_add_epi8(acc, _mm512_loadu_si512((const void*)(s_dup + h_compact_col[i] + j)));
+        }
+        _mm512_storeu_si512((void*)(upc + j), acc);
+    }
+}
+
+void threshold_block_avx512(OUT uint8_t black[R_BITS],
+        OUT uint8_t gray[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t T,
+        IN const uint8_t T_gray,
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = THRESHOLD_END(first, count);
+    const __m512i vT = _mm512_set1_epi8((char)T);
+    const __m512i vT_gray = _mm512_set1_epi8((char)T_gray);
+    const __m512i one = _mm512_set1_epi8(1);
+    uint32_t j = first;
+
+    for (; j + 64 <= end; j += 64)
+    {
+        const __m512i c = _mm512_loadu_si512((const void*)(upc + j));
+        const __mmask64 b = _mm512_cmpge_epu8_mask(c, vT);
+        const __mmask64 g = _mm512_cmpge_epu8_mask(c, vT_gray) & ~b;
+        _mm512_storeu_si512((void*)(black + j), _mm512_maskz_mov_epi8(b, one));
+        _mm512_storeu_si512((void*)(gray + j), _mm512_maskz_mov_epi8(g, one));
+    }
+
+    // the tail fits one masked store
+    if (j < end)
+    {
+        const __mmask64 tail = (__mmask64)MASK(end - j);
+        const __m512i c = _mm512_loadu_si512((const void*)(upc + j));
+        const __mmask64 b = _mm512_cmpge_epu8_mask(c, vT);
+        const __mmask64 g = _mm512_cmpge_epu8_mask(c, vT_gray) & ~b;
+        _mm512_mask_storeu_epi8((void*)(black + j), tail, _mm512_maskz_mov_epi8(b, one));
+        _mm512_mask_storeu_epi8((void*)(gray + j), tail, _mm512_maskz_mov_epi8(g, one));
+    }
+}
+
+void threshold_masked_block_avx512(OUT uint8_t flip[R_BITS],
+        IN const uint8_t upc[R_PADDED_BITS],
+        IN const uint8_t mask[R_BITS],
+        IN const uint8_t T,
+        IN const uint32_t first,
+        IN const uint32_t count)
+{
+    const uint32_t end = THRESHOLD_END(first, count);
+    const __m512i vT = _mm512_set1_epi8((char)T);
+    uint32_t j = first;
+
+    for (; j + 64 <= end; j += 64)
+    {
+        const __m512i c = _mm512_loadu_si512((const void*)(upc + j));
+        const __m512i m = _mm512_loadu_si512((const void*)(mask + j));
+        _mm512_storeu_si512((void*)(flip + j),
+                _mm512_maskz_mov_epi8(_mm512_cmpge_epu8_mask(c, vT), m));
+    }
+
+    if (j < end)
+    {
+        const __mmask64 tail = (__mmask64)MASK(end - j);
+        const __m512i c = _mm512_loadu_si512((const void*)(upc + j));
+        const __m512i m = _mm512_maskz_loadu_epi8(tail, (const void*)(mask + j));
+        _mm512_mask_storeu_epi8((void*)(flip + j), tail,
+                _mm512_maskz_mov_epi8(_mm512_cmpge_epu8_mask(c, vT), m));
+    }
+}
+
+#pragma GCC pop_options
+
+#endif //DECODE_HAVE_AVX512
@@ -0,0 +1,204 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "decode.h"
+#include "utilities.h"
+
+#include <string.h>
+
+// Bit-packed BGF decoder of the BIKE_LOW_MEM profile. The syndrome and the
+// error stay in the polynomial format and the counters are recomputed from
+// the syndrome bits, so no array holds a byte per bit. It makes the same
+// decisions as BGF_decoder: the counter of position j of block b is the
+// number of unsatisfied equations s[(h_b[i] + j) % R_BITS] (BGF_decoder
+// reads the transposed syndrome instead), and flipping j adds x^j*h_b to s.
+
+#ifdef BIKE_LOW_MEM
+
+_INLINE_ uint32_t get_bit(IN const uint8_t* a, IN const uint32_t i)
+{
+    return (a[i / 8] >> (i % 8)) & 1;
+}
+
+_INLINE_ void flip_bit(IN OUT uint8_t* a, IN const uint32_t i)
+{
+    a[i / 8] ^= (uint8_t)(1U << (i % 8));
+}
+
+_INLINE_ uint32_t packed_weight(IN const uint8_t s[R_SIZE])
+{
+    uint32_t w = 0;
+    for (uint32_t i = 0; i < R_SIZE; i++)
+    {
+        w += __builtin_popcount(s[i]);
+    }
+    return w;
+}
+
+// Counter of position pos (0..N_BITS-1) of e.
+_INLINE_ uint32_t packed_upc(IN const uint8_t s[R_SIZE],
+        IN const uint32_t pos,
+        IN const uint32_t h0_compact[DV],
+        IN const uint32_t h1_compact[DV])
+{
+    const uint32_t* h = (pos < R_BITS) ? h0_compact : h1_compact;
+    const uint32_t j = (pos < R_BITS) ? pos : (pos - R_BITS);
+    uint32_t upc = 0;
+
+    for (uint32_t i = 0; i < DV; i++)
+    {
+        uint32_t idx = h[i] + j;
+        idx -= (idx >= R_BITS) ? R_BITS : 0;
+        upc += get_bit(s, idx);
+    }
+    return upc;
+}
+
+// Flip position pos of e and update the syndrome.
+_INLINE_ void packed_flip(IN OUT uint8_t e[N_SIZE],
+        IN OUT uint8_t s[R_SIZE],
+        IN const uint32_t pos,
+        IN const uint32_t h0_compact[DV],
+        IN const uint32_t h1_compact[DV])
+{
+    const uint32_t* h = (pos < R_BITS) ? h0_compact : h1_compact;
+    const uint32_t j = (pos < R_BITS) ? pos : (pos - R_BITS);
+
+    flip_bit(e, pos);
+    for (uint32_t i = 0; i < DV; i++)
+    {
+        uint32_t idx = h[i] + j;
+        idx -= (idx >= R_BITS) ? R_BITS : 0;
+        flip_bit(s, idx);
+    }
+}
+
+// Flip every position marked in flip (all counters were taken before).
+_INLINE_ void packed_flip_marked(IN OUT uint8_t e[N_SIZE],
+        IN OUT uint8_t s[R_SIZE],
+        IN const uint8_t flip[N_SIZE],
+        IN const uint32_t h0_compact[DV],
+        IN const uint32_t h1_compact[DV])
+{
+    for (uint32_t i = 0; i < N_SIZE; i++)
+    {
+        for (uint32_t b = 0; (b < 8) && (flip[i] >> b); b++)
+        {
+            if ((flip[i] >> b) & 1)
+            {
+                packed_flip(e, s, 8*i + b, h0_compact, h1_compact);
+            }
+        }
+    }
+}
+
+static void packed_bf_iter(IN OUT uint8_t e[N_SIZE],
+        IN OUT uint8_t s[R_SIZE],
+        IN const uint32_t T,
+        IN const uint32_t h0_compact[DV],
+        IN const uint32_t h1_compact[DV],
+        OUT uint8_t black[N_SIZE],
+        OUT uint8_t gray[N_SIZE])
+{
+    memset(black, 0, N_SIZE);
+    memset(gray, 0, N_SIZE);
+
+    for (uint32_t pos = 0; pos < N_BITS; pos++)
+    {
+        const uint32_t upc = packed_upc(s, pos, h0_compact, h1_compact);
+
+        if (upc >= T)
+        {
+            flip_bit(black, pos);
+        }
+        // an empty gray range when T < tau
+        else if ((T >= tau) && (upc >= T - tau))
+        {
+            flip_bit(gray, pos);
+        }
+    }
+
+    packed_flip_marked(e, s, black, h0_compact, h1_compact);
+}
+
+// Flip the positions of mask whose counter reaches T; mask is consumed.
+static void packed_bf_masked_iter(IN OUT uint8_t e[N_SIZE],
+        IN OUT uint8_t s[R_SIZE],
+        IN OUT uint8_t mask[N_SIZE],
+        IN const uint32_t T,
+        IN const uint32_t h0_compact[DV],
+        IN const uint32_t h1_compact[DV])
+{
+    for (uint32_t pos = 0; pos < N_BITS; pos++)
+    {
+        if (get_bit(mask, pos) && (packed_upc(s, pos, h0_compact, h1_compact) < T))
+        {
+            flip_bit(mask, pos);
+        }
+    }
+
+    packed_flip_marked(e, s, mask, h0_compact, h1_compact);
+}
+
+int BGF_decoder_packed_ws(OUT uint8_t e[N_SIZE],
+        IN OUT uint8_t s[R_SIZE],
+        IN const uint32_t h0_compact[DV],
+        IN const uint32_t h1_compact[DV],
+        IN OUT bike_ws_t* ws)
+{
+    memset(e, 0, N_SIZE);
+
+    for (int i = 1; i <= NbIter; i++)
+    {
+        const uint32_t T = bgf_threshold(packed_weight(s));
+
+        packed_bf_iter(e, s, T, h0_compact, h1_compact, ws->black, ws->gray);
+
+        if (i == 1)
+        {
+            packed_bf_masked_iter(e, s, ws->black, (DV+1)/2 + 1, h0_compact, h1_compact);
+            packed_bf_masked_iter(e, s, ws->gray, (DV+1)/2 + 1, h0_compact, h1_compact);
+        }
+    }
+
+    if (packed_weight(s) == 0)
+        return 0; // SUCCESS
+    else
+        return 1; // FAILURE
+}
+
+#endif //BIKE_LOW_MEM
@@ -0,0 +1,460 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "decode_parallel.h"
+#include "decode.h"
+#include "dispatch.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+// Positions of one block in units of UPC_PAD (the granule of the kernels).
+#define PAR_CHUNKS (R_PADDED_BITS / UPC_PAD)
+
+// Spins before a waiting thread yields (barriers) or sleeps (between jobs).
+#define PAR_SPIN_LIMIT 4096
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__arm__) || defined(__aarch64__)
+#define CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define CPU_RELAX()
+#endif
+
+// Byte-per-bit decoders only.
+#ifndef BIKE_LOW_MEM
+
+typedef struct par_barrier_s
+{
+    uint32_t count;
+    uint32_t sense;
+    uint32_t n;
+} par_barrier_t;
+
+typedef struct par_slot_s
+{
+    bike_decode_pool_t* pool WS_ALIGNED;
+    // local sense of the barrier
+    uint32_t sense;
+    // chunks [chunk_first, chunk_last) of h0 || h1
+    uint32_t chunk_first;
+    uint32_t chunk_last;
+    // syndrome slice [s_first, s_last)
+    uint32_t s_first;
+    uint32_t s_last;
+    // outputs of the last phase
+    uint32_t nflips;
+    uint32_t weight;
+    pthread_t thread;
+} par_slot_t;
+
+struct bike_decode_pool_s
+{
+    // counters of both blocks, and the flip lists: the list of a worker
+    // starts at its first position, so the lists never overlap
+    uint8_t upc[2][R_PADDED_BITS] WS_ALIGNED;
+    uint32_t flips[2*R_PADDED_BITS] WS_ALIGNED;
+
+    par_barrier_t barrier WS_ALIGNED;
+
+    // job generation, bumped by worker 0 to start a decode
+    uint32_t gen WS_ALIGNED;
+    uint32_t stop;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+
+    // the current decode
+    uint8_t* e;
+    uint8_t* s;
+    uint32_t* h0_compact;
+    uint32_t* h1_compact;
+    uint32_t h0_compact_col[DV];
+    uint32_t h1_compact_col[DV];
+    bike_ws_t* ws;
+
+    uint32_t n;
+    par_slot_t* slots;
+};
+
+_INLINE_ void par_barrier_wait(IN OUT par_barrier_t* b, IN OUT uint32_t* sense)
+{
+    const uint32_t s = (*sense ^= 1);
+
+    if (__atomic_add_fetch(&b->count, 1, __ATOMIC_ACQ_REL) == b->n)
+    {
+        // last one in: reset and release the others
+        __atomic_store_n(&b->count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&b->sense, s, __ATOMIC_RELEASE);
+        return;
+    }
+
+    uint32_t spins = 0;
+    while (__atomic_load_n(&b->sense, __ATOMIC_ACQUIRE) != s)
+    {
+        CPU_RELAX();
+        if (++spins == PAR_SPIN_LIMIT)
+        {
+            // more workers than free cores
+            sched_yield();
+            spins = 0;
+        }
+    }
+}
+
+// Copy the slice of s to both halves of s_dup and count its weight.
+static void par_refresh_slice(IN OUT bike_decode_pool_t* pool, IN OUT par_slot_t* slot)
+{
+    const uint32_t len = slot->s_last - slot->s_first;
+    const uint8_t* s = pool->s + slot->s_first;
+    uint8_t* s_dup = pool->ws->s_dup + slot->s_first;
+
+    memcpy(s_dup, s, len);
+    memcpy(s_dup + R_BITS, s, len);
+    slot->weight = getHammingWeight(s, len);
+}
+
+// Syndrome weight, summed in worker order.
+_INLINE_ uint32_t par_weight(IN const bike_decode_pool_t* pool)
+{
+    uint32_t weight = 0;
+    for (uint32_t w = 0; w < pool->n; w++)
+    {
+        weight += pool->slots[w].weight;
+    }
+    return weight;
+}
+
+// Counters and marks of the worker's positions; flips the marked ones in e
+// and lists them. mask == NULL: BFIter (black and gray marks, black ones
+// flipped), otherwise BFMaskedIter (flip marks in ws->pos).
+static void par_sweep(IN OUT bike_decode_pool_t* pool,
+        IN OUT par_slot_t* slot,
+        IN const uint8_t* mask,
+        IN const uint8_t T_ctr,
+        IN const uint8_t T_gray)
+{
+    const bike_dispatch_t* d = bike_dispatch();
+    bike_ws_t* ws = pool->ws;
+    uint32_t* list = pool->flips + slot->chunk_first * UPC_PAD;
+    uint32_t nflips = 0;
+
+    for (uint32_t b = 0; b < 2; b++)
+    {
+        const uint32_t lo = (slot->chunk_first > b*PAR_CHUNKS) ? slot->chunk_first : b*PAR_CHUNKS;
+        const uint32_t hi = (slot->chunk_last < (b+1)*PAR_CHUNKS) ? slot->chunk_last : (b+1)*PAR_CHUNKS;
+        if (lo >= hi)
+        {
+            continue;
+        }
+
+        const uint32_t first = (lo - b*PAR_CHUNKS) * UPC_PAD;
+        const uint32_t count = (hi - lo) * UPC_PAD;
+        uint8_t* marks = ((mask == NULL) ? ws->black : ws->pos) + b*R_BITS;
+
+        d->upc_block(pool->upc[b], ws->s_dup,
+                (b == 0) ? pool->h0_compact_col : pool->h1_compact_col, first, count);
+        if (mask == NULL)
+        {
+            d->threshold_block(marks, ws->gray + b*R_BITS, pool->upc[b], T_ctr, T_gray, first, count);
+        }
+        else
+        {
+            d->threshold_masked_block(marks, pool->upc[b], mask + b*R_BITS, T_ctr, first, count);
+        }
+
+        const uint32_t end = THRESHOLD_END(first, count);
+        for (uint32_t j = first; j < end; j++)
+        {
+            if (marks[j])
+            {
+                flipAdjustedErrorPosition(pool->e, b*R_BITS + j);
+                list[nflips++] = b*R_BITS + j;
+            }
+        }
+    }
+    slot->nflips = nflips;
+}
+
+// recompute_syndrome of every listed flip, restricted to the worker's slice.
+static void par_update_slice(IN OUT bike_decode_pool_t* pool, IN OUT par_slot_t* slot)
+{
+    uint8_t* s = pool->s;
+    const uint32_t s_first = slot->s_first;
+    const uint32_t s_len = slot->s_last - slot->s_first;
+
+    for (uint32_t w = 0; w < pool->n; w++)
+    {
+        const uint32_t* list = pool->flips + pool->slots[w].chunk_first * UPC_PAD;
+        for (uint32_t f = 0; f < pool->slots[w].nflips; f++)
+        {
+            const uint32_t pos = list[f];
+            const uint32_t* h = (pos < R_BITS) ? pool->h0_compact : pool->h1_compact;
+            const uint32_t q = (pos < R_BITS) ? pos : (pos - R_BITS);
+
+            for (uint32_t k = 0; k < DV; k++)
+            {
+                const uint32_t i = (h[k] <= q) ? (q - h[k]) : (R_BITS - h[k] + q);
+                if ((i - s_first) < s_len)
+                {
+                    s[i] ^= 1;
+                }
+            }
+        }
+    }
+
+    par_refresh_slice(pool, slot);
+}
+
+_INLINE_ void par_flip(IN OUT bike_decode_pool_t* pool,
+        IN OUT par_slot_t* slot,
+        IN const uint8_t* mask,
+        IN const uint8_t T_ctr,
+        IN const uint8_t T_gray)
+{
+    par_sweep(pool, slot, mask, T_ctr, T_gray);
+    par_barrier_wait(&pool->barrier, &slot->sense);
+    par_update_slice(pool, slot);
+    par_barrier_wait(&pool->barrier, &slot->sense);
+}
+
+// The iterations of BGF_decoder_ws, run by every worker of the pool.
+static void par_bgf(IN OUT bike_decode_pool_t* pool, IN OUT par_slot_t* slot)
+{
+    bike_ws_t* ws = pool->ws;
+
+    par_refresh_slice(pool, slot);
+    par_barrier_wait(&pool->barrier, &slot->sense);
+
+    for (int i = 1; i <= NbIter; i++)
+    {
+        const uint32_t T = bgf_threshold(par_weight(pool));
+        const uint8_t T_ctr = ctr_threshold(T);
+        const uint8_t T_gray = (T < tau) ? T_ctr : ctr_threshold(T - tau);
+
+        par_flip(pool, slot, NULL, T_ctr, T_gray);
+
+        if (i == 1)
+        {
+            const uint8_t T_mask = ctr_threshold((DV+1)/2 + 1);
+            par_flip(pool, slot, ws->black, T_mask, T_mask);
+            par_flip(pool, slot, ws->gray, T_mask, T_mask);
+        }
+    }
+}
+
+static void* par_thread(IN void* arg)
+{
+    par_slot_t* slot = (par_slot_t*)arg;
+    bike_decode_pool_t* pool = slot->pool;
+    uint32_t seen = 0;
+
+    for (;;)
+    {
+        uint32_t gen;
+        uint32_t spins = 0;
+
+        while ((gen = __atomic_load_n(&pool->gen, __ATOMIC_ACQUIRE)) == seen)
+        {
+            CPU_RELAX();
+            if (++spins == PAR_SPIN_LIMIT)
+            {
+                // idle: sleep until the next job
+                pthread_mutex_lock(&pool->lock);
+                while (__atomic_load_n(&pool->gen, __ATOMIC_ACQUIRE) == seen)
+                {
+                    pthread_cond_wait(&pool->wake, &pool->lock);
+                }
+                pthread_mutex_unlock(&pool->lock);
+                spins = 0;
+            }
+        }
+        seen = gen;
+
+        if (__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE))
+        {
+            return NULL;
+        }
+        par_bgf(pool, slot);
+    }
+}
+
+_INLINE_ void par_start(IN OUT bike_decode_pool_t* pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    __atomic_add_fetch(&pool->gen, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+_INLINE_ void par_pin(IN pthread_t thread, IN const uint32_t k)
+{
+#ifdef __linux__
+    const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu > 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(k % (uint32_t)ncpu, &set);
+        // best effort: an unpinned worker is only slower
+        pthread_setaffinity_np(thread, sizeof(set), &set);
+    }
+#else
+    (void)thread;
+    (void)k;
+#endif
+}
+
+bike_decode_pool_t* bike_decode_pool_create(IN const uint32_t n_threads)
+{
+    if ((n_threads == 0) || (n_threads > 2*PAR_CHUNKS))
+    {
+        return NULL;
+    }
+
+    void* mem = NULL;
+    if (posix_memalign(&mem, BIKE_WS_ALIGN, sizeof(bike_decode_pool_t)) != 0)
+    {
+        return NULL;
+    }
+    bike_decode_pool_t* pool = (bike_decode_pool_t*)mem;
+    memset(pool, 0, sizeof(bike_decode_pool_t));
+
+    if (posix_memalign(&mem, BIKE_WS_ALIGN, n_threads * sizeof(par_slot_t)) != 0)
+    {
+        free(pool);
+        return NULL;
+    }
+    pool->slots = (par_slot_t*)mem;
+    memset(pool->slots, 0, n_threads * sizeof(par_slot_t));
+
+    pool->n = n_threads;
+    pool->barrier.n = n_threads;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    for (uint32_t w = 0; w < n_threads; w++)
+    {
+        par_slot_t* slot = &pool->slots[w];
+        slot->pool = pool;
+        slot->chunk_first = (w * 2*PAR_CHUNKS) / n_threads;
+        slot->chunk_last = ((w + 1) * 2*PAR_CHUNKS) / n_threads;
+        slot->s_first = (uint32_t)(((uint64_t)w * R_BITS) / n_threads);
+        slot->s_last = (uint32_t)(((uint64_t)(w + 1) * R_BITS) / n_threads);
+    }
+
+    for (uint32_t w = 1; w < n_threads; w++)
+    {
+        if (pthread_create(&pool->slots[w].thread, NULL, par_thread, &pool->slots[w]) != 0)
+        {
+            // join the ones already running
+            pool->n = w;
+            bike_decode_pool_destroy(pool);
+            return NULL;
+        }
+        par_pin(pool->slots[w].thread, w);
+    }
+
+    return pool;
+}
+
+void bike_decode_pool_destroy(IN bike_decode_pool_t* pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    __atomic_store_n(&pool->stop, 1, __ATOMIC_RELEASE);
+    par_start(pool);
+    for (uint32_t w = 1; w < pool->n; w++)
+    {
+        pthread_join(pool->slots[w].thread, NULL);
+    }
+
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->slots);
+    free(pool);
+}
+
+int BGF_decoder_parallel_ws(uint8_t e[R_BITS*2],
+    uint8_t s[R_BITS],
+    uint32_t h0_compact[DV],
+    uint32_t h1_compact[DV],
+    bike_decode_pool_t* pool,
+    bike_ws_t* ws)
+{
+    memset(e, 0, R_BITS*2);
+    memset(ws->s_dup + 2*R_BITS, 0, UPC_PAD);
+
+    pool->e = e;
+    pool->s = s;
+    pool->h0_compact = h0_compact;
+    pool->h1_compact = h1_compact;
+    getCol(pool->h0_compact_col, h0_compact);
+    getCol(pool->h1_compact_col, h1_compact);
+    pool->ws = ws;
+
+    par_start(pool);
+    par_bgf(pool, &pool->slots[0]);
+
+    if (par_weight(pool) == 0)
+        return 0; // SUCCESS
+    else
+        return 1; // FAILURE
+}
+
+int BGF_decoder_parallel(uint8_t e[R_BITS*2],
+    uint8_t s[R_BITS],
+    uint32_t h0_compact[DV],
+    uint32_t h1_compact[DV],
+    bike_decode_pool_t* pool)
+{
+    bike_ws_t* ws = bike_ws_thread();
+    if (ws == NULL)
+    {
+        return 1; // FAILURE
+    }
+
+    return BGF_decoder_parallel_ws(e, s, h0_compact, h1_compact, pool, ws);
+}
+
+#endif //BIKE_LOW_MEM
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _DECODE_PARALLEL_H_
+#define _DECODE_PARALLEL_H_
+
+#include "types.h"
+#include "workspace.h"
+
+// Parallel BGF decoder. The counter sweeps of an iteration are split among
+// the workers of a pool: each one takes a range of positions of h0 || h1,
+// computes their counters and marks, flips them in e and lists them. After
+// a barrier, each worker applies all the lists (in worker order) to its own
+// slice of the syndrome. The flips of an iteration all depend on the
+// syndrome of its start, so e and s match BGF_decoder_ws bit for bit.
+//
+// The phases are separated by sense-reversing spin barriers. Between two
+// decodes the pool threads spin for a while and then sleep.
+
+typedef struct bike_decode_pool_s bike_decode_pool_t;
+
+#ifndef BIKE_LOW_MEM
+
+// Pool of n_threads workers. The thread calling a decoder is worker 0;
+// workers 1..n_threads-1 are threads pinned to CPU k mod the number of
+// online CPUs (Linux). Returns NULL if n_threads is 0, larger than the
+// number of UPC_PAD-position ranges, or if the threads cannot be created.
+bike_decode_pool_t* bike_decode_pool_create(IN const uint32_t n_threads);
+
+// Stop and join the pool threads; a NULL pool is ignored.
+void bike_decode_pool_destroy(IN bike_decode_pool_t* pool);
+
+// BGF_decoder_ws on the workers of pool. A pool runs one decode at a time.
+int BGF_decoder_parallel_ws(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        bike_decode_pool_t* pool,
+        bike_ws_t* ws);
+
+// Same on the thread workspace; fails (returns 1) if it cannot be allocated.
+int BGF_decoder_parallel(uint8_t e[R_BITS*2],
+        uint8_t s[R_BITS],
+        uint32_t h0_compact[DV],
+        uint32_t h1_compact[DV],
+        bike_decode_pool_t* pool);
+
+#endif //BIKE_LOW_MEM
+
+#endif //_DECODE_PARALLEL_H_
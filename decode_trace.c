@@ -0,0 +1,93 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "decode_trace.h"
+
+#ifdef BIKE_DECODER_TRACE
+
+static __thread bgf_trace_rec_t g_ring[BGF_TRACE_RING];
+static __thread uint32_t g_head = 0;
+static __thread uint32_t g_count = 0;
+static __thread uint64_t g_dropped = 0;
+static __thread bgf_trace_fn g_fn = NULL;
+static __thread void* g_arg = NULL;
+
+void bgf_trace_set_callback(IN bgf_trace_fn fn, IN void* arg)
+{
+    g_fn = fn;
+    g_arg = arg;
+}
+
+uint32_t bgf_trace_read(OUT bgf_trace_rec_t* out, IN const uint32_t max)
+{
+    const uint32_t n = (g_count < max) ? g_count : max;
+    const uint32_t first = (g_head + BGF_TRACE_RING - g_count) % BGF_TRACE_RING;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        out[i] = g_ring[(first + i) % BGF_TRACE_RING];
+    }
+    g_count -= n;
+
+    return n;
+}
+
+uint64_t bgf_trace_dropped(void)
+{
+    return g_dropped;
+}
+
+void bgf_trace_emit(IN const bgf_trace_rec_t* rec)
+{
+    g_ring[g_head] = *rec;
+    g_head = (g_head + 1) % BGF_TRACE_RING;
+    if (g_count < BGF_TRACE_RING)
+    {
+        g_count++;
+    }
+    else
+    {
+        g_dropped++;
+    }
+
+    if (g_fn != NULL)
+    {
+        g_fn(rec, g_arg);
+    }
+}
+
+#endif //BIKE_DECODER_TRACE
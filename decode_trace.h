@@ -0,0 +1,96 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _DECODE_TRACE_H_
+#define _DECODE_TRACE_H_
+
+#include "types.h"
+
+#ifdef BIKE_DECODER_TRACE
+
+// Steps of a BGF decode, in the order they are recorded.
+#define BGF_TRACE_ITER          0 // black/gray iteration (flips the black marks)
+#define BGF_TRACE_MASKED_BLACK  1 // masked iteration on the black marks of iteration 1
+#define BGF_TRACE_MASKED_GRAY   2 // masked iteration on the gray marks of iteration 1
+#define BGF_TRACE_END           3 // end of the decode
+
+// Records kept per thread; older ones are overwritten.
+#define BGF_TRACE_RING 64U
+
+// One step. The per-block counts are for h0 and h1 (positions 0..R_BITS-1
+// and R_BITS..N_BITS-1). Times are in bike_ticks units
+// (utilities.h).
+typedef struct bgf_trace_rec_s
+{
+    // decodes of this thread so far, and the iteration (1..n_iter)
+    uint32_t decode;
+    uint32_t iter;
+    uint32_t kind;
+    // before the step; BGF_TRACE_END: left after the last iteration
+    uint32_t syndrome_weight;
+    // flip threshold of the step (0 for BGF_TRACE_END)
+    uint32_t threshold;
+    uint32_t black[2];
+    uint32_t gray[2];
+    uint32_t flips[2];
+    // counter and threshold kernels, flips of e, syndrome updates
+    uint64_t t_counters;
+    uint64_t t_flip;
+    uint64_t t_syndrome;
+    // BGF_TRACE_END: the whole decode
+    uint64_t t_total;
+} bgf_trace_rec_t;
+
+typedef void (*bgf_trace_fn)(IN const bgf_trace_rec_t* rec, IN void* arg);
+
+// Calls fn(rec, arg) for every record of this thread (NULL: none), in
+// addition to the ring.
+void bgf_trace_set_callback(IN bgf_trace_fn fn, IN void* arg);
+
+// Moves up to max records of this thread's ring to out, oldest first, and
+// returns their number.
+uint32_t bgf_trace_read(OUT bgf_trace_rec_t* out, IN const uint32_t max);
+
+// Records dropped from this thread's ring because it was full.
+uint64_t bgf_trace_dropped(void);
+
+// Adds a record to the ring and calls the callback (decode.c).
+void bgf_trace_emit(IN const bgf_trace_rec_t* rec);
+
+#endif //BIKE_DECODER_TRACE
+
+#endif //_DECODE_TRACE_H_
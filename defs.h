@@ -42,10 +42,13 @@
 //         BIKE main parameters
 ///////////////////////////////////////////
 
-// UNCOMMENT TO SELECT THE NIST SECURITY LEVEL 1, 3 OR 5:
+// UNCOMMENT TO SELECT THE NIST SECURITY LEVEL 1, 3 OR 5
+// (levels/ builds all three, defining the level before this file):
+#if !defined(PARAM64) && !defined(PARAM96) && !defined(PARAM128)
 #define PARAM64 // NIST LEVEL 1
 // #define PARAM96 // NIST LEVEL 3
 // #define PARAM128 // NIST LEVEL 5
+#endif
 
 // UNCOMMENT TO ENABLE BANDWIDTH OPTIMISATION FOR BIKE-3:
 //#define BANDWIDTH_OPTIMIZED
@@ -90,6 +93,83 @@
 #define NbIter 5
 #endif
 
+// Threshold rule of the BGF decoder, applied through the integer tables of
+// threshold_tables.h: THRESHOLD_AFFINE is VAR_TH_FCT above, THRESHOLD_EXACT
+// the compute_threshold model of threshold.c.
+#define THRESHOLD_AFFINE 0
+#define THRESHOLD_EXACT  1
+#ifndef BGF_THRESHOLD_RULE
+#define BGF_THRESHOLD_RULE THRESHOLD_AFFINE
+#endif
+
+// Decoder of crypto_kem_dec: DECODER_BGF or DECODER_BACKFLIP.
+#define DECODER_BGF      0
+#define DECODER_BACKFLIP 1
+#ifndef DECODER
+#define DECODER DECODER_BGF
+#endif
+
+// Backflip: iteration budget, and time to live of a flip (in iterations)
+// from the margin delta = counter - threshold:
+// min(max(0.45 delta + 1.1, 1), BACKFLIP_MAX_TTL), computed by backflip_ttl
+// (decode_backflip.c). BACKFLIP_MAX_TTL must be below FLIP_QUEUE_WHEEL
+// (checked in flip_queue.h).
+#ifndef BACKFLIP_NB_ITER
+#define BACKFLIP_NB_ITER 100
+#endif
+#ifndef BACKFLIP_MAX_TTL
+#define BACKFLIP_MAX_TTL 5
+#endif
+
+// Counter engine of the byte-per-bit decoders: UPC_ENGINE_DIRECT, the
+// kernels of the bound backend, or UPC_ENGINE_NTT, an experimental integer
+// convolution by number-theoretic transform (decode_kernels_ntt.c) for
+// research parameters with a large r.
+#define UPC_ENGINE_DIRECT 0
+#define UPC_ENGINE_NTT    1
+#ifndef UPC_ENGINE
+#define UPC_ENGINE UPC_ENGINE_DIRECT
+#endif
+
+// Positions per tile of the portable counter kernel (a multiple of 64).
+// A tile of UPC_TILE counters is accumulated from DV syndrome windows of
+// UPC_TILE bytes; consecutive tiles read adjacent windows, so DV*UPC_TILE
+// is kept below ~18 KB to stay resident in a 32 KB L1D.
+#ifndef UPC_TILE
+#ifdef PARAM64
+#define UPC_TILE 256
+#else
+#define UPC_TILE 128
+#endif
+#endif
+
+// BIKE_DECODER_TRACE: BGF_decoder_cfg_ws (and so crypto_kem_dec) records
+// every iteration in a per-thread ring and an optional callback
+// (decode_trace.h). Off by default: the decoder then has no trace code.
+
+// BIKE_STAGE_TIMING: keygen, encaps and decaps add the time of each of
+// their stages to per-thread accumulators (kem_stages.h). Off by default.
+
+// BIKE_LOW_MEM: build profile for small embedded targets (README.txt).
+// Decapsulation keeps the syndrome, the error and the decoder marks
+// bit-packed in one workspace whose buffers are shared by its phases, the
+// polynomial arithmetic is in-tree (no NTL/GMP) and only the portable
+// kernels are built. The batched decapsulation is not available.
+#ifdef BIKE_LOW_MEM
+#ifndef BIKE_PORTABLE
+#define BIKE_PORTABLE
+#endif
+#if (DECODER != DECODER_BGF)
+#error "BIKE_LOW_MEM supports the BGF decoder only"
+#endif
+#if (UPC_ENGINE != UPC_ENGINE_DIRECT)
+#error "BIKE_LOW_MEM computes the counters bit-packed (no UPC_ENGINE)"
+#endif
+#ifdef BIKE_DECODER_TRACE
+#error "BIKE_DECODER_TRACE traces the byte-per-bit BGF decoder (not in BIKE_LOW_MEM)"
+#endif
+#endif
+
 // Divide by the divider and round up to next integer:
 #define DIVIDE_AND_CEIL(x, divider)  ((x/divider) + (x % divider == 0 ? 0 : 1ULL))
 
@@ -134,8 +214,9 @@
 //              Printing
 ///////////////////////////////////////////
 
-// Show timer results in cycles.
-#define RDTSC
+// Show timer results in TSC cycles on x86-64 (measurements.h). Without it,
+// and on other targets, MEASURE reads the perf_event_open counters.
+//#define RDTSC
 
 //#define PRINT_IN_BE
 //#define NO_SPACE
@@ -0,0 +1,270 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "dispatch.h"
+#include "ntl.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#elif defined(__arm__) || defined(__aarch64__)
+#include <sys/auxv.h>
+#endif
+
+// UPC_ENGINE_NTT replaces the counter kernel of every backend.
+#if (UPC_ENGINE == UPC_ENGINE_NTT)
+#define UPC_BLOCK(kernel) upc_block_ntt
+#else
+#define UPC_BLOCK(kernel) kernel
+#endif
+
+#ifdef BIKE_LOW_MEM
+static const bike_dispatch_t portable_table = {
+    BIKE_BACKEND_PORTABLE, "portable",
+    gf2x_mod_mul_portable, gf2x_mod_mul_portable_ws, gf2x_mod_inv_portable,
+    UPC_BLOCK(upc_block_portable), threshold_block_portable, threshold_masked_block_portable,
+    KeccakF1600, KeccakF1600_multi_portable,
+    convertByteToBinary_portable, convertBinaryToByte_portable
+};
+#else
+// NTL keeps the temporaries of a product on its own heap.
+static void ntl_mod_mul_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws)
+{
+    (void)ws;
+    ntl_mod_mul(res, a, b);
+}
+
+static const bike_dispatch_t portable_table = {
+    BIKE_BACKEND_PORTABLE, "portable",
+    ntl_mod_mul, ntl_mod_mul_ws, ntl_mod_inv,
+    UPC_BLOCK(upc_block_portable), threshold_block_portable, threshold_masked_block_portable,
+    KeccakF1600, KeccakF1600_multi_portable,
+    convertByteToBinary_portable, convertBinaryToByte_portable
+};
+#endif
+
+#ifdef GF2X_HAVE_PCLMUL
+static const bike_dispatch_t pclmul_table = {
+    BIKE_BACKEND_PCLMUL, "pclmul",
+    gf2x_mod_mul_pclmul, gf2x_mod_mul_pclmul_ws, gf2x_mod_inv_pclmul,
+    UPC_BLOCK(upc_block_portable), threshold_block_portable, threshold_masked_block_portable,
+    KeccakF1600_words, KeccakF1600_multi_portable,
+    convertByteToBinary_portable, convertBinaryToByte_portable
+};
+#endif
+
+#ifdef KECCAK_HAVE_AVX2
+#define KECCAK_F1600_MULTI_AVX2 KeccakF1600_multi_avx2
+#else
+#define KECCAK_F1600_MULTI_AVX2 KeccakF1600_multi_portable
+#endif
+
+#if defined(GF2X_HAVE_PCLMUL) && defined(DECODE_HAVE_AVX2) && defined(CONVERSIONS_HAVE_AVX2)
+static const bike_dispatch_t avx2_table = {
+    BIKE_BACKEND_AVX2, "avx2",
+    gf2x_mod_mul_pclmul, gf2x_mod_mul_pclmul_ws, gf2x_mod_inv_pclmul,
+    UPC_BLOCK(upc_block_avx2), threshold_block_avx2, threshold_masked_block_avx2,
+    KeccakF1600_words, KECCAK_F1600_MULTI_AVX2,
+    convertByteToBinary_avx2, convertBinaryToByte_avx2
+};
+#endif
+
+#if defined(GF2X_HAVE_PCLMUL) && defined(DECODE_HAVE_AVX512) && defined(CONVERSIONS_HAVE_AVX2)
+static const bike_dispatch_t avx512_table = {
+    BIKE_BACKEND_AVX512, "avx512",
+    gf2x_mod_mul_pclmul, gf2x_mod_mul_pclmul_ws, gf2x_mod_inv_pclmul,
+    UPC_BLOCK(upc_block_avx512), threshold_block_avx512, threshold_masked_block_avx512,
+    KeccakF1600_words, KECCAK_F1600_MULTI_AVX2,
+    convertByteToBinary_avx2, convertBinaryToByte_avx2
+};
+#endif
+
+#if defined(GF2X_HAVE_NEON) && defined(DECODE_HAVE_NEON)
+static const bike_dispatch_t neon_table = {
+    BIKE_BACKEND_NEON, "neon",
+    gf2x_mod_mul_neon, gf2x_mod_mul_neon_ws, gf2x_mod_inv_neon,
+    UPC_BLOCK(upc_block_neon), threshold_block_neon, threshold_masked_block_neon,
+    KeccakF1600_words, KeccakF1600_multi_portable,
+    convertByteToBinary_portable, convertBinaryToByte_portable
+};
+#endif
+
+static const bike_dispatch_t* backend_table(IN const bike_backend_t backend)
+{
+    switch (backend)
+    {
+#ifdef GF2X_HAVE_PCLMUL
+        case BIKE_BACKEND_PCLMUL: return &pclmul_table;
+#endif
+#if defined(GF2X_HAVE_PCLMUL) && defined(DECODE_HAVE_AVX2) && defined(CONVERSIONS_HAVE_AVX2)
+        case BIKE_BACKEND_AVX2: return &avx2_table;
+#endif
+#if defined(GF2X_HAVE_PCLMUL) && defined(DECODE_HAVE_AVX512) && defined(CONVERSIONS_HAVE_AVX2)
+        case BIKE_BACKEND_AVX512: return &avx512_table;
+#endif
+#if defined(GF2X_HAVE_NEON) && defined(DECODE_HAVE_NEON)
+        case BIKE_BACKEND_NEON: return &neon_table;
+#endif
+        case BIKE_BACKEND_PORTABLE: return &portable_table;
+        default: return NULL;
+    }
+}
+
+#if defined(__x86_64__)
+
+// Feature bits of cpuid leaves 1 (ecx) and 7 (ebx), plus the OS support
+// of the AVX and AVX-512 register state (xcr0).
+static int cpu_supports(IN const bike_backend_t backend)
+{
+    uint32_t eax, ebx, ecx, edx;
+    uint32_t xcr0_lo = 0, xcr0_hi = 0;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return 0;
+    }
+
+    const int pclmul = (ecx >> 1) & 1;
+    const int osxsave = (ecx >> 27) & 1;
+
+    if (osxsave)
+    {
+        asm volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    }
+
+    const int ymm_state = ((xcr0_lo & 0x06) == 0x06);
+    const int zmm_state = ((xcr0_lo & 0xe6) == 0xe6);
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+        ebx = 0;
+    }
+
+    const int avx2 = ((ebx >> 5) & 1) && ymm_state;
+    const int avx512 = ((ebx >> 16) & 1) && ((ebx >> 30) & 1) && zmm_state;
+
+    switch (backend)
+    {
+        case BIKE_BACKEND_PORTABLE: return 1;
+        case BIKE_BACKEND_PCLMUL:   return pclmul;
+        case BIKE_BACKEND_AVX2:     return pclmul && avx2;
+        case BIKE_BACKEND_AVX512:   return pclmul && avx2 && avx512;
+        default:                    return 0;
+    }
+}
+
+#elif defined(__arm__) || defined(__aarch64__)
+
+#ifndef HWCAP_NEON
+#define HWCAP_NEON (1 << 12)
+#endif
+
+static int cpu_supports(IN const bike_backend_t backend)
+{
+    switch (backend)
+    {
+        case BIKE_BACKEND_PORTABLE: return 1;
+#if defined(__aarch64__)
+        // Advanced SIMD is mandatory on AArch64
+        case BIKE_BACKEND_NEON:     return 1;
+#else
+        case BIKE_BACKEND_NEON:     return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#endif
+        default:                    return 0;
+    }
+}
+
+#else
+
+static int cpu_supports(IN const bike_backend_t backend)
+{
+    return (backend == BIKE_BACKEND_PORTABLE);
+}
+
+#endif
+
+int bike_backend_supported(IN const bike_backend_t backend)
+{
+    return (backend_table(backend) != NULL) && cpu_supports(backend);
+}
+
+static const bike_dispatch_t* g_dispatch = &portable_table;
+static pthread_once_t g_dispatch_once = PTHREAD_ONCE_INIT;
+
+static void dispatch_init(void)
+{
+    // the last supported backend is the fastest
+    for (uint32_t b = 0; b < BIKE_BACKEND_COUNT; b++)
+    {
+        if (bike_backend_supported((bike_backend_t)b))
+        {
+            g_dispatch = backend_table((bike_backend_t)b);
+        }
+    }
+
+    // an empty BIKE_BACKEND= is the same as unset
+    const char* forced = getenv("BIKE_BACKEND");
+    if ((forced == NULL) || (forced[0] == '\0'))
+    {
+        return;
+    }
+
+    for (uint32_t b = 0; b < BIKE_BACKEND_COUNT; b++)
+    {
+        const bike_dispatch_t* t = backend_table((bike_backend_t)b);
+        if ((t != NULL) && (strcmp(forced, t->name) == 0) && cpu_supports((bike_backend_t)b))
+        {
+            g_dispatch = t;
+            return;
+        }
+    }
+
+    fprintf(stderr, "BIKE_BACKEND=%s is not available, using %s\n", forced, g_dispatch->name);
+}
+
+const bike_dispatch_t* bike_dispatch(void)
+{
+    pthread_once(&g_dispatch_once, dispatch_init);
+    return g_dispatch;
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _DISPATCH_H_
+#define _DISPATCH_H_
+
+#include "types.h"
+#include "gf2x.h"
+#include "decode_kernels.h"
+#include "keccak_multi.h"
+#include "conversions.h"
+
+// Run-time selection of the hot kernels. On first use the CPU features are
+// read (cpuid on x86-64, AT_HWCAP on ARM) and the fastest backend they
+// allow is bound. Setting BIKE_BACKEND to one of the names below forces
+// that backend when the CPU supports it (e.g. for benchmarking).
+
+typedef enum
+{
+    BIKE_BACKEND_PORTABLE = 0, // "portable": NTL (BIKE_LOW_MEM: in-tree) and C code
+    BIKE_BACKEND_PCLMUL   = 1, // "pclmul": PCLMULQDQ products
+    BIKE_BACKEND_AVX2     = 2, // "avx2": PCLMULQDQ and AVX2 kernels
+    BIKE_BACKEND_AVX512   = 3, // "avx512": PCLMULQDQ and AVX-512BW kernels
+    BIKE_BACKEND_NEON     = 4, // "neon": NEON products and kernels
+    BIKE_BACKEND_COUNT
+} bike_backend_t;
+
+typedef struct bike_dispatch_s
+{
+    bike_backend_t backend;
+    const char* name;
+
+    gf2x_mod_mul_t mod_mul;
+    gf2x_mod_mul_ws_t mod_mul_ws;
+    gf2x_mod_inv_t mod_inv;
+
+    upc_block_t upc_block;
+    threshold_block_t threshold_block;
+    threshold_masked_block_t threshold_masked_block;
+
+    keccak_permute_t keccak_f1600;
+    keccak_multi_permute_t keccak_f1600_multi;
+
+    conversion_t byte_to_binary;
+    conversion_t binary_to_byte;
+} bike_dispatch_t;
+
+// The bound table; initialized once, thread-safe.
+const bike_dispatch_t* bike_dispatch(void);
+
+// Whether this build and CPU can run the backend.
+int bike_backend_supported(IN const bike_backend_t backend);
+
+#endif //_DISPATCH_H_
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "flip_queue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Link nodes n..FLIP_QUEUE_CAPACITY-1 as the free list.
+static void fq_init_free(OUT flip_queue_t* q)
+{
+    for (uint32_t n = 0; n < FLIP_QUEUE_CAPACITY; n++)
+    {
+        q->node[n].next = (uint16_t)(n + 1);
+    }
+    q->node[FLIP_QUEUE_CAPACITY - 1].next = FQ_NODE_NIL;
+    q->free = 0;
+}
+
+void fq_init(OUT flip_queue_t* q)
+{
+    memset(q->slot, 0, sizeof(q->slot));
+    for (uint32_t b = 0; b < FLIP_QUEUE_WHEEL; b++)
+    {
+        q->head[b] = FQ_NODE_NIL;
+    }
+    fq_init_free(q);
+    q->length = 0;
+}
+
+flip_queue_t* fq_alloc(void)
+{
+    flip_queue_t* q = (flip_queue_t*)malloc(sizeof(flip_queue_t));
+    if (q == NULL)
+    {
+        return NULL;
+    }
+
+    fq_init(q);
+
+    return q;
+}
+
+void fq_free(flip_queue_t* q)
+{
+    free(q);
+}
+
+void fq_reset(IN OUT flip_queue_t* q)
+{
+    for (uint32_t b = 0; b < FLIP_QUEUE_WHEEL; b++)
+    {
+        uint16_t n = q->head[b];
+        while (n != FQ_NODE_NIL)
+        {
+            const uint16_t next = q->node[n].next;
+            q->slot[q->node[n].pos] = 0;
+            q->node[n].next = q->free;
+            q->free = n;
+            n = next;
+        }
+        q->head[b] = FQ_NODE_NIL;
+    }
+    q->length = 0;
+}
+
+int fq_insert(IN OUT flip_queue_t* q, IN const uint32_t j, IN const uint32_t expiry)
+{
+    const uint32_t b = expiry % FLIP_QUEUE_WHEEL;
+    const uint16_t n = q->free;
+
+    if (n == FQ_NODE_NIL)
+    {
+        return 1;
+    }
+    q->free = q->node[n].next;
+
+    q->node[n].pos = j;
+    q->node[n].next = q->head[b];
+    q->node[n].prev = FQ_NODE_NIL;
+    if (q->head[b] != FQ_NODE_NIL)
+    {
+        q->node[q->head[b]].prev = n;
+    }
+    q->head[b] = n;
+    q->slot[j] = (uint16_t)(n + 1);
+    q->length++;
+
+    return 0;
+}
+
+// Unlink node n from bucket b and return it to the free list.
+_INLINE_ void fq_unlink(IN OUT flip_queue_t* q, IN const uint32_t b, IN const uint16_t n)
+{
+    fq_node_t* node = &q->node[n];
+
+    if (node->prev != FQ_NODE_NIL)
+    {
+        q->node[node->prev].next = node->next;
+    }
+    else
+    {
+        q->head[b] = node->next;
+    }
+
+    if (node->next != FQ_NODE_NIL)
+    {
+        q->node[node->next].prev = node->prev;
+    }
+
+    q->slot[node->pos] = 0;
+    node->next = q->free;
+    q->free = n;
+    q->length--;
+}
+
+void fq_remove(IN OUT flip_queue_t* q, IN const uint32_t j)
+{
+    const uint16_t n = (uint16_t)(q->slot[j] - 1U);
+
+    // the bucket only matters when n heads its list
+    uint32_t b = 0;
+    if (q->node[n].prev == FQ_NODE_NIL)
+    {
+        while (q->head[b] != n)
+        {
+            b++;
+        }
+    }
+    fq_unlink(q, b, n);
+}
+
+uint32_t fq_pop_expired(IN OUT flip_queue_t* q, IN const uint32_t it)
+{
+    const uint32_t b = it % FLIP_QUEUE_WHEEL;
+    const uint16_t n = q->head[b];
+
+    if (n == FQ_NODE_NIL)
+    {
+        return FQ_NIL;
+    }
+
+    const uint32_t j = q->node[n].pos;
+    fq_unlink(q, b, n);
+    return j;
+}
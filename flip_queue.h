@@ -0,0 +1,115 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _FLIP_QUEUE_H_
+#define _FLIP_QUEUE_H_
+
+#include "types.h"
+
+// Queue of pending flips of a queue-driven decoder (Backflip), keyed by
+// the iteration at which each flip expires. It is a time wheel: bucket
+// (expiry % FLIP_QUEUE_WHEEL) holds a doubly-linked list of the positions
+// expiring then. The list nodes come from a pool of FLIP_QUEUE_CAPACITY
+// entries with 16-bit links, and slot[j] finds the node of position j, so
+// a position costs 2 bytes. Insert, remove and pop are O(1), the queue is a
+// single allocation, and fq_reset empties it in O(length) for the next
+// decode.
+//
+// All pending expiries must lie within FLIP_QUEUE_WHEEL - 1 iterations of
+// the oldest one, i.e. a time to live below FLIP_QUEUE_WHEEL. A decode
+// keeps about as many flips pending as the error has bits (at most
+// T1 + 30 in bike-dfr-sim runs up to weight 6000), so the pool holds 4*T1.
+
+#define FLIP_QUEUE_WHEEL 8U
+#ifndef FLIP_QUEUE_CAPACITY
+#define FLIP_QUEUE_CAPACITY (4U * T1)
+#endif
+#define FQ_NIL UINT32_MAX
+#define FQ_NODE_NIL 0xffffU
+
+typedef struct fq_node_s
+{
+    uint32_t pos;
+    uint16_t next;
+    uint16_t prev;
+} fq_node_t;
+
+typedef struct flip_queue_s
+{
+    uint16_t head[FLIP_QUEUE_WHEEL];
+    // unused nodes, linked through next
+    uint16_t free;
+    uint32_t length;
+
+    fq_node_t node[FLIP_QUEUE_CAPACITY];
+    // 0 if position j (0..N_BITS-1) is not queued, else its node + 1
+    uint16_t slot[N_BITS];
+} flip_queue_t;
+
+#if (FLIP_QUEUE_CAPACITY == 0) || (FLIP_QUEUE_CAPACITY >= FQ_NODE_NIL)
+#error "FLIP_QUEUE_CAPACITY must be between 1 and 65534"
+#endif
+#if (BACKFLIP_MAX_TTL < 1) || (BACKFLIP_MAX_TTL >= FLIP_QUEUE_WHEEL)
+#error "BACKFLIP_MAX_TTL must be between 1 and FLIP_QUEUE_WHEEL - 1"
+#endif
+
+// Make q an empty queue (q may be uninitialized memory).
+void fq_init(OUT flip_queue_t* q);
+
+// Returns NULL if the allocation fails.
+flip_queue_t* fq_alloc(void);
+void fq_free(flip_queue_t* q);
+
+// Empty the queue, keeping its storage.
+void fq_reset(IN OUT flip_queue_t* q);
+
+_INLINE_ int fq_contains(IN const flip_queue_t* q, IN const uint32_t j)
+{
+    return q->slot[j] != 0;
+}
+
+// Queue position j (not queued yet) to expire at iteration expiry.
+// Returns 0, or 1 (q unchanged) when all FLIP_QUEUE_CAPACITY nodes are used.
+int fq_insert(IN OUT flip_queue_t* q, IN const uint32_t j, IN const uint32_t expiry);
+
+// Remove the queued position j.
+void fq_remove(IN OUT flip_queue_t* q, IN const uint32_t j);
+
+// Remove and return one position expiring at iteration it, or FQ_NIL.
+uint32_t fq_pop_expired(IN OUT flip_queue_t* q, IN const uint32_t it);
+
+#endif //_FLIP_QUEUE_H_
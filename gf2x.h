@@ -0,0 +1,199 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _GF2X_H_
+#define _GF2X_H_
+
+#include "types.h"
+
+// In-tree arithmetic in GF(2)[x]/(x^R_BITS - 1) on 64-bit words.
+// A polynomial is stored little-endian: bit i of the R_SIZE-byte
+// representation is the coefficient of x^i (the NTL byte format).
+
+#define R_QWORDS DIVIDE_AND_CEIL(R_BITS, 64ULL)
+
+// Karatsuba recursion stops at operands of GF2X_BASE_QWORDS words, which
+// are multiplied by the backend base case.
+#define GF2X_BASE_QWORDS 8ULL
+
+// Operand length rounded up to whole base cases.
+#define GF2X_PADDED_QWORDS (DIVIDE_AND_CEIL(R_QWORDS, GF2X_BASE_QWORDS) * GF2X_BASE_QWORDS)
+
+// Scratch words needed by the Karatsuba recursion: 8h per level, where the
+// half size h exceeds n/2 by less than one base case.
+#define GF2X_SCRATCH_QWORDS (8ULL * (GF2X_PADDED_QWORDS + 8ULL * GF2X_BASE_QWORDS))
+
+// c[0..2*GF2X_BASE_QWORDS) = a[0..GF2X_BASE_QWORDS) * b[0..GF2X_BASE_QWORDS)
+typedef void (*gf2x_mul_base_t)(OUT uint64_t *c,
+        IN const uint64_t *a,
+        IN const uint64_t *b);
+
+// Base cases: 64x64 carry-less products in C, with PCLMULQDQ and with
+// NEON VMULL.P8. The SIMD ones are compiled for their instruction set
+// regardless of CFLAGS and only run when dispatch.c detects it.
+// Defining BIKE_PORTABLE keeps only the C code.
+void gf2x_mul_base_portable(OUT uint64_t *c,
+        IN const uint64_t *a,
+        IN const uint64_t *b);
+
+#if !defined(BIKE_PORTABLE) && defined(__x86_64__)
+#define GF2X_HAVE_PCLMUL
+void gf2x_mul_base_pclmul(OUT uint64_t *c,
+        IN const uint64_t *a,
+        IN const uint64_t *b);
+#endif
+
+#if !defined(BIKE_PORTABLE) && (defined(__arm__) || defined(__aarch64__) || defined(__ARM_NEON))
+#define GF2X_HAVE_NEON
+void gf2x_mul_base_neon(OUT uint64_t *c,
+        IN const uint64_t *a,
+        IN const uint64_t *b);
+#endif
+
+// Temporaries of one Karatsuba product (several pages at level 5).
+typedef struct gf2x_ws_s
+{
+    uint64_t a64[GF2X_PADDED_QWORDS];
+    uint64_t b64[GF2X_PADDED_QWORDS];
+    uint64_t c64[2 * GF2X_PADDED_QWORDS];
+    uint64_t r64[R_QWORDS];
+    uint64_t scratch[GF2X_SCRATCH_QWORDS];
+} gf2x_ws_t;
+
+// res = a*b mod (x^R_BITS - 1) by Karatsuba over the given base case, with
+// the temporaries in ws (gf2x_mod_mul_karatsuba: on the stack).
+void gf2x_mod_mul_karatsuba_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        IN gf2x_mul_base_t base,
+        OUT gf2x_ws_t* ws);
+
+void gf2x_mod_mul_karatsuba(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        IN gf2x_mul_base_t base);
+
+typedef void (*gf2x_mod_mul_t)(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE]);
+
+typedef void (*gf2x_mod_mul_ws_t)(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws);
+
+typedef void (*gf2x_mod_inv_t)(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE]);
+
+// The products and inversion over the C base case. These replace NTL in
+// the BIKE_LOW_MEM profile.
+void gf2x_mod_mul_portable(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE]);
+void gf2x_mod_mul_portable_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws);
+void gf2x_mod_inv_portable(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE]);
+
+#ifdef GF2X_HAVE_PCLMUL
+void gf2x_mod_mul_pclmul(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE]);
+void gf2x_mod_mul_pclmul_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws);
+void gf2x_mod_inv_pclmul(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE]);
+#endif
+
+#ifdef GF2X_HAVE_NEON
+void gf2x_mod_mul_neon(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE]);
+void gf2x_mod_mul_neon_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws);
+void gf2x_mod_inv_neon(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE]);
+#endif
+
+// res = a^-1 mod (x^R_BITS - 1) by Itoh-Tsujii: a^-1 = a^(2^(R_BITS-1) - 2),
+// about log2(R_BITS) products with the given multiplication, the repeated
+// squarings being bit permutations.
+void gf2x_mod_inv_itoh_tsujii(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN gf2x_mod_mul_t mul);
+
+// res = a*h mod (x^R_BITS - 1) for a sparse h given by its support
+// wlist[0..weight), as the sum of the rotations of a by wlist[i]: weight
+// word passes and no temporaries. The bits of a above R_BITS must be zero.
+void gf2x_mod_mul_sparse(OUT uint64_t res[R_QWORDS],
+        IN const uint64_t a[R_QWORDS],
+        IN const uint32_t wlist[],
+        IN const uint32_t weight);
+
+// res = a + b mod (x^R_BITS - 1).
+void gf2x_mod_add(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE]);
+
+// Split e = e0 + x^R_BITS*e1 (N_SIZE bytes) into its two halves.
+void gf2x_split(OUT uint8_t e0[R_SIZE],
+        OUT uint8_t e1[R_SIZE],
+        IN const uint8_t e[N_SIZE]);
+
+// res = a*b and res = a^-1 mod (x^R_BITS - 1) with the backend selected at
+// run time (dispatch.h). Used for every product and inversion of keygen,
+// encaps and the decaps syndrome.
+void gf2x_mod_mul(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE]);
+
+// Same as gf2x_mod_mul with the temporaries of the product in ws.
+void gf2x_mod_mul_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws);
+
+void gf2x_mod_inv(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE]);
+
+#endif //_GF2X_H_
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "gf2x.h"
+#include "dispatch.h"
+
+#include <string.h>
+
+// res = a^(2^k) mod (x^R_BITS - 1). Squaring is linear over GF(2) and maps
+// x^i to x^(2i mod R_BITS), so k squarings move coefficient i to
+// i * 2^k mod R_BITS. The loop reads every bit without branching on it.
+_INLINE_ void gf2x_mod_sqr_k(OUT uint64_t res[R_QWORDS],
+        IN const uint64_t a[R_QWORDS],
+        IN const uint32_t k)
+{
+    uint64_t m = 1;
+    for (uint32_t i = 0; i < k; i++)
+    {
+        m = (2 * m) % R_BITS;
+    }
+
+    memset(res, 0, R_QWORDS * sizeof(uint64_t));
+
+    uint64_t j = 0;
+    for (uint32_t i = 0; i < R_BITS; i++)
+    {
+        res[j / 64] |= ((a[i / 64] >> (i % 64)) & 1) << (j % 64);
+
+        j += m;
+        j -= (j >= R_BITS) ? R_BITS : 0;
+    }
+}
+
+void gf2x_mod_inv_itoh_tsujii(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN gf2x_mod_mul_t mul)
+{
+    // f = a^(2^k - 1), built along the bits of n = R_BITS - 2 by
+    // f_2k = f_k^(2^k) * f_k and f_k+1 = f_k^2 * a.
+    uint64_t a64[R_QWORDS] = {0};
+    uint64_t f[R_QWORDS];
+    uint64_t t[R_QWORDS];
+    const uint32_t n = R_BITS - 2;
+    uint32_t k = 1;
+    int top = 31;
+
+    memcpy(a64, a, R_SIZE);
+    memcpy(f, a64, sizeof(f));
+
+    while (((n >> top) & 1) == 0)
+    {
+        top--;
+    }
+
+    for (int i = top - 1; i >= 0; i--)
+    {
+        gf2x_mod_sqr_k(t, f, k);
+        mul((uint8_t*)f, (const uint8_t*)t, (const uint8_t*)f);
+        k *= 2;
+
+        if ((n >> i) & 1)
+        {
+            gf2x_mod_sqr_k(t, f, 1);
+            mul((uint8_t*)f, (const uint8_t*)t, (const uint8_t*)a64);
+            k++;
+        }
+    }
+
+    // a^-1 = (a^(2^(R_BITS-2) - 1))^2
+    gf2x_mod_sqr_k(t, f, 1);
+    memcpy(res, t, R_SIZE);
+}
+
+void gf2x_mod_inv_portable(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE])
+{
+    gf2x_mod_inv_itoh_tsujii(res, a, gf2x_mod_mul_portable);
+}
+
+#ifdef GF2X_HAVE_PCLMUL
+void gf2x_mod_inv_pclmul(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE])
+{
+    gf2x_mod_inv_itoh_tsujii(res, a, gf2x_mod_mul_pclmul);
+}
+#endif
+
+#ifdef GF2X_HAVE_NEON
+void gf2x_mod_inv_neon(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE])
+{
+    gf2x_mod_inv_itoh_tsujii(res, a, gf2x_mod_mul_neon);
+}
+#endif
+
+void gf2x_mod_inv(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE])
+{
+    bike_dispatch()->mod_inv(res, a);
+}
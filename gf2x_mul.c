@@ -0,0 +1,343 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "gf2x.h"
+#include "dispatch.h"
+
+#include <string.h>
+
+// 64x64 carry-less product with a 4-bit window. The table holds a' * i for
+// the low 60 bits a' of a (so that no product overflows 64 bits); the top
+// four bits of a are added separately. All lookups and masks are
+// independent of the operand values except for the table index.
+_INLINE_ void clmul64_portable(OUT uint64_t *lo,
+        OUT uint64_t *hi,
+        IN const uint64_t a,
+        IN const uint64_t b)
+{
+    const uint64_t a_low = a & MASK(60);
+    uint64_t u[16];
+    uint64_t l, h = 0;
+
+    u[0] = 0;
+    u[1] = a_low;
+    for (uint32_t i = 2; i < 16; i += 2)
+    {
+        u[i] = u[i / 2] << 1;
+        u[i + 1] = u[i] ^ a_low;
+    }
+
+    l = u[b & 0xf];
+    for (uint32_t i = 4; i < 64; i += 4)
+    {
+        const uint64_t t = u[(b >> i) & 0xf];
+        l ^= t << i;
+        h ^= t >> (64 - i);
+    }
+
+    for (uint32_t i = 60; i < 64; i++)
+    {
+        const uint64_t mask = 0 - ((a >> i) & 1);
+        l ^= (b << i) & mask;
+        h ^= (b >> (64 - i)) & mask;
+    }
+
+    *lo = l;
+    *hi = h;
+}
+
+void gf2x_mul_base_portable(OUT uint64_t *c,
+        IN const uint64_t *a,
+        IN const uint64_t *b)
+{
+    uint64_t lo, hi;
+
+    memset(c, 0, 2 * GF2X_BASE_QWORDS * sizeof(uint64_t));
+
+    for (uint32_t i = 0; i < GF2X_BASE_QWORDS; i++)
+    {
+        for (uint32_t j = 0; j < GF2X_BASE_QWORDS; j++)
+        {
+            clmul64_portable(&lo, &hi, a[i], b[j]);
+            c[i + j]     ^= lo;
+            c[i + j + 1] ^= hi;
+        }
+    }
+}
+
+// c[0..2n) = a[0..n) * b[0..n), n a multiple of GF2X_BASE_QWORDS.
+// The high half of each operand is zero-padded to the size of the low half,
+// so uneven lengths still split into two equal sub-products.
+static void karatsuba(OUT uint64_t *c,
+        IN const uint64_t *a,
+        IN const uint64_t *b,
+        IN const uint32_t n,
+        IN uint64_t *scratch,
+        IN gf2x_mul_base_t base)
+{
+    if (n == GF2X_BASE_QWORDS)
+    {
+        base(c, a, b);
+        return;
+    }
+
+    const uint32_t h = DIVIDE_AND_CEIL(n, (2 * GF2X_BASE_QWORDS)) * GF2X_BASE_QWORDS;
+    const uint32_t l = n - h;
+
+    uint64_t *a1 = scratch;
+    uint64_t *b1 = a1 + h;
+    uint64_t *as = b1 + h;
+    uint64_t *bs = as + h;
+    uint64_t *z2 = bs + h;
+    uint64_t *zm = z2 + 2 * h;
+    uint64_t *next = zm + 2 * h;
+
+    memset(a1, 0, 2 * h * sizeof(uint64_t));
+    memcpy(a1, a + h, l * sizeof(uint64_t));
+    memcpy(b1, b + h, l * sizeof(uint64_t));
+
+    for (uint32_t i = 0; i < h; i++)
+    {
+        as[i] = a[i] ^ a1[i];
+        bs[i] = b[i] ^ b1[i];
+    }
+
+    // z0 = a0*b0 in the low part of c, z2 = a1*b1, zm = (a0+a1)(b0+b1)
+    karatsuba(c, a, b, h, next, base);
+    karatsuba(z2, a1, b1, h, next, base);
+    karatsuba(zm, as, bs, h, next, base);
+
+    // zm = z0 + z1 + z2, the middle term
+    for (uint32_t i = 0; i < 2 * h; i++)
+    {
+        zm[i] ^= c[i] ^ z2[i];
+    }
+
+    // a1*b1 has only 2l non-zero words
+    memcpy(c + 2 * h, z2, 2 * l * sizeof(uint64_t));
+
+    for (uint32_t i = 0; i < 2 * h; i++)
+    {
+        if (h + i < 2 * n)
+        {
+            c[h + i] ^= zm[i];
+        }
+    }
+}
+
+// res = p mod (x^R_BITS - 1), for deg(p) < 2*R_BITS - 1.
+_INLINE_ void reduce(OUT uint64_t res[R_QWORDS],
+        IN const uint64_t *p)
+{
+    const uint32_t q = R_BITS / 64;
+    const uint32_t s = R_BITS % 64;
+
+    for (uint32_t i = 0; i < R_QWORDS; i++)
+    {
+        res[i] = p[i] ^ (p[i + q] >> s) ^ (p[i + q + 1] << (64 - s));
+    }
+
+    res[R_QWORDS - 1] &= MASK(s);
+}
+
+void gf2x_mod_mul_karatsuba_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        IN gf2x_mul_base_t base,
+        OUT gf2x_ws_t* ws)
+{
+    memset(ws->a64, 0, sizeof(ws->a64));
+    memset(ws->b64, 0, sizeof(ws->b64));
+    memcpy(ws->a64, a, R_SIZE);
+    memcpy(ws->b64, b, R_SIZE);
+
+    karatsuba(ws->c64, ws->a64, ws->b64, GF2X_PADDED_QWORDS, ws->scratch, base);
+    reduce(ws->r64, ws->c64);
+
+    memcpy(res, ws->r64, R_SIZE);
+}
+
+void gf2x_mod_mul_karatsuba(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        IN gf2x_mul_base_t base)
+{
+    gf2x_ws_t ws;
+    gf2x_mod_mul_karatsuba_ws(res, a, b, base, &ws);
+}
+
+void gf2x_mod_mul_portable(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE])
+{
+    gf2x_mod_mul_karatsuba(res, a, b, gf2x_mul_base_portable);
+}
+
+void gf2x_mod_mul_portable_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws)
+{
+    gf2x_mod_mul_karatsuba_ws(res, a, b, gf2x_mul_base_portable, ws);
+}
+
+#ifdef GF2X_HAVE_PCLMUL
+void gf2x_mod_mul_pclmul(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE])
+{
+    gf2x_mod_mul_karatsuba(res, a, b, gf2x_mul_base_pclmul);
+}
+
+void gf2x_mod_mul_pclmul_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws)
+{
+    gf2x_mod_mul_karatsuba_ws(res, a, b, gf2x_mul_base_pclmul, ws);
+}
+#endif
+
+#ifdef GF2X_HAVE_NEON
+void gf2x_mod_mul_neon(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE])
+{
+    gf2x_mod_mul_karatsuba(res, a, b, gf2x_mul_base_neon);
+}
+
+void gf2x_mod_mul_neon_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws)
+{
+    gf2x_mod_mul_karatsuba_ws(res, a, b, gf2x_mul_base_neon, ws);
+}
+#endif
+
+// Bits start..start+63 of a (R_BITS bits), the indices taken mod R_BITS.
+_INLINE_ uint64_t rotated_word(IN const uint64_t a[R_QWORDS],
+        IN const uint32_t start)
+{
+    const uint32_t q = start / 64;
+    const uint32_t s = start % 64;
+
+    uint64_t w = a[q] >> s;
+    if ((s != 0) && (q + 1 < R_QWORDS))
+    {
+        w |= a[q + 1] << (64 - s);
+    }
+
+    // wrap around to bit 0 (the bits of a above R_BITS are zero)
+    if (start + 64 > R_BITS)
+    {
+        w |= a[0] << (R_BITS - start);
+    }
+
+    return w;
+}
+
+void gf2x_mod_mul_sparse(OUT uint64_t res[R_QWORDS],
+        IN const uint64_t a[R_QWORDS],
+        IN const uint32_t wlist[],
+        IN const uint32_t weight)
+{
+    memset(res, 0, R_QWORDS * sizeof(uint64_t));
+
+    // bit k of x^i*a is bit (k - i) mod R_BITS of a
+    for (uint32_t i = 0; i < weight; i++)
+    {
+        uint32_t start = R_BITS - wlist[i];
+        for (uint32_t w = 0; w < R_QWORDS; w++)
+        {
+            start -= (start >= R_BITS) ? R_BITS : 0;
+            res[w] ^= rotated_word(a, start);
+            start += 64;
+        }
+    }
+
+    res[R_QWORDS - 1] &= MASK(R_BITS % 64);
+}
+
+void gf2x_mod_add(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE])
+{
+    for (uint32_t i = 0; i < R_SIZE; i++)
+    {
+        res[i] = a[i] ^ b[i];
+    }
+}
+
+void gf2x_split(OUT uint8_t e0[R_SIZE],
+        OUT uint8_t e1[R_SIZE],
+        IN const uint8_t e[N_SIZE])
+{
+    const uint32_t q = R_BITS / 8;
+    const uint32_t s = R_BITS % 8;
+
+    memcpy(e0, e, R_SIZE);
+    if (s != 0)
+    {
+        e0[R_SIZE - 1] &= MASK(s);
+    }
+
+    for (uint32_t i = 0; i < R_SIZE; i++)
+    {
+        uint32_t b = (q + i < N_SIZE) ? (e[q + i] >> s) : 0;
+        if ((s != 0) && (q + i + 1 < N_SIZE))
+        {
+            b |= (uint32_t)e[q + i + 1] << (8 - s);
+        }
+        e1[i] = (uint8_t)b;
+    }
+}
+
+void gf2x_mod_mul(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE])
+{
+    bike_dispatch()->mod_mul(res, a, b);
+}
+
+void gf2x_mod_mul_ws(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE],
+        OUT gf2x_ws_t* ws)
+{
+    bike_dispatch()->mod_mul_ws(res, a, b, ws);
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "gf2x.h"
+
+#ifdef GF2X_HAVE_NEON
+
+// An ARMv7 build for cores without NEON still carries this code.
+#pragma GCC push_options
+#if defined(__arm__) && !defined(__ARM_NEON__)
+#pragma GCC target("fpu=neon")
+#endif
+
+#include <arm_neon.h>
+
+// 8x8-bit polynomial product of each byte lane (VMULL.P8).
+_INLINE_ uint64x2_t pmull8(IN const uint8x8_t a, IN const uint8x8_t b)
+{
+    return vreinterpretq_u64_p16(vmull_p8(vreinterpret_p8_u8(a), vreinterpret_p8_u8(b)));
+}
+
+// Folds the 16-bit lane products of byte rotations by k (lanes that
+// wrapped around the 64-bit operand carry to the top): t.lo ^= t.hi,
+// t.hi &= mask, t.lo ^= t.hi.
+_INLINE_ uint8x16_t fold(IN const uint64x2_t t, IN const uint64_t mask)
+{
+    uint64x1_t lo = veor_u64(vget_low_u64(t), vget_high_u64(t));
+    const uint64x1_t hi = vand_u64(vget_high_u64(t), vcreate_u64(mask));
+    lo = veor_u64(lo, hi);
+    return vreinterpretq_u8_u64(vcombine_u64(lo, hi));
+}
+
+// 64x64 carry-less product out of eight VMULL.P8 (Camara, Gouvea, Lopez,
+// Dahab: "Fast software polynomial multiplication on ARM processors using
+// the NEON engine"). A_k/B_k are the operands rotated by k bytes;
+// D = A*B, L = A1*B + A*B1, M = A2*B + A*B2, N = A3*B + A*B3, K = A*B4
+// and the sum is D + L<<8 + M<<16 + N<<24 + K<<32.
+_INLINE_ uint64x2_t clmul64_neon(IN const uint64_t a64, IN const uint64_t b64)
+{
+    const uint8x8_t a = vcreate_u8(a64);
+    const uint8x8_t b = vcreate_u8(b64);
+
+    const uint64x2_t l = veorq_u64(pmull8(vext_u8(a, a, 1), b), pmull8(a, vext_u8(b, b, 1)));
+    const uint64x2_t m = veorq_u64(pmull8(vext_u8(a, a, 2), b), pmull8(a, vext_u8(b, b, 2)));
+    const uint64x2_t n = veorq_u64(pmull8(vext_u8(a, a, 3), b), pmull8(a, vext_u8(b, b, 3)));
+    const uint64x2_t k = pmull8(a, vext_u8(b, b, 4));
+    const uint64x2_t d = pmull8(a, b);
+
+    uint8x16_t t0 = fold(l, 0x0000ffffffffffffULL);
+    uint8x16_t t1 = fold(m, 0x00000000ffffffffULL);
+    uint8x16_t t2 = fold(n, 0x000000000000ffffULL);
+    uint8x16_t t3 = fold(k, 0);
+
+    // shift the 128-bit terms left by 1, 2, 3 and 4 bytes
+    t0 = vextq_u8(t0, t0, 15);
+    t1 = vextq_u8(t1, t1, 14);
+    t2 = vextq_u8(t2, t2, 13);
+    t3 = vextq_u8(t3, t3, 12);
+
+    const uint64x2_t t01 = veorq_u64(vreinterpretq_u64_u8(t0), vreinterpretq_u64_u8(t1));
+    const uint64x2_t t23 = veorq_u64(vreinterpretq_u64_u8(t2), vreinterpretq_u64_u8(t3));
+    return veorq_u64(d, veorq_u64(t01, t23));
+}
+
+// ARMv7 NEON base case: 8x8-word schoolbook product. The 128-bit products
+// a[i]*b[j] are summed per diagonal i+j; even diagonals tile c exactly and
+// odd diagonals are the same tiling one word up.
+void gf2x_mul_base_neon(OUT uint64_t *c,
+        IN const uint64_t *a,
+        IN const uint64_t *b)
+{
+    uint64x2_t diag[2 * GF2X_BASE_QWORDS - 1];
+    uint64_t odd[2 * GF2X_BASE_QWORDS] = {0};
+
+    for (uint32_t i = 0; i < 2 * GF2X_BASE_QWORDS - 1; i++)
+    {
+        diag[i] = vdupq_n_u64(0);
+    }
+
+    for (uint32_t i = 0; i < GF2X_BASE_QWORDS; i++)
+    {
+        for (uint32_t j = 0; j < GF2X_BASE_QWORDS; j++)
+        {
+            diag[i + j] = veorq_u64(diag[i + j], clmul64_neon(a[i], b[j]));
+        }
+    }
+
+    for (uint32_t i = 0; i < GF2X_BASE_QWORDS; i++)
+    {
+        vst1q_u64(&c[2 * i], diag[2 * i]);
+    }
+    for (uint32_t i = 0; i < GF2X_BASE_QWORDS - 1; i++)
+    {
+        vst1q_u64(&odd[2 * i + 1], diag[2 * i + 1]);
+    }
+    for (uint32_t i = 1; i < 2 * GF2X_BASE_QWORDS - 1; i++)
+    {
+        c[i] ^= odd[i];
+    }
+}
+
+#pragma GCC pop_options
+
+#endif //GF2X_HAVE_NEON
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "gf2x.h"
+
+#ifdef GF2X_HAVE_PCLMUL
+
+#include <string.h>
+#include <wmmintrin.h>
+#include <emmintrin.h>
+
+#pragma GCC push_options
+#pragma GCC target("pclmul,sse2")
+
+// x86-64 base case: 8x8-word schoolbook product on PCLMULQDQ. Word pairs
+// of a are multiplied by each word of b, and each 128-bit product is added
+// at its word offset.
+void gf2x_mul_base_pclmul(OUT uint64_t *c,
+        IN const uint64_t *a,
+        IN const uint64_t *b)
+{
+    __m128i acc[2 * GF2X_BASE_QWORDS];
+
+    for (uint32_t i = 0; i < 2 * GF2X_BASE_QWORDS; i++)
+    {
+        acc[i] = _mm_setzero_si128();
+    }
+
+    for (uint32_t i = 0; i < GF2X_BASE_QWORDS; i += 2)
+    {
+        const __m128i va = _mm_loadu_si128((const __m128i*)&a[i]);
+
+        for (uint32_t j = 0; j < GF2X_BASE_QWORDS; j++)
+        {
+            const __m128i vb = _mm_set1_epi64x((long long)b[j]);
+
+            // a[i]*b[j] lands at word i+j, a[i+1]*b[j] at word i+j+1
+            acc[i + j]     = _mm_xor_si128(acc[i + j],     _mm_clmulepi64_si128(va, vb, 0x00));
+            acc[i + j + 1] = _mm_xor_si128(acc[i + j + 1], _mm_clmulepi64_si128(va, vb, 0x01));
+        }
+    }
+
+    // fold the 128-bit partial products of consecutive words
+    uint64_t lo[2 * GF2X_BASE_QWORDS + 1] = {0};
+    for (uint32_t i = 0; i < 2 * GF2X_BASE_QWORDS; i++)
+    {
+        uint64_t t[2];
+        _mm_storeu_si128((__m128i*)t, acc[i]);
+        lo[i]     ^= t[0];
+        lo[i + 1] ^= t[1];
+    }
+
+    memcpy(c, lo, 2 * GF2X_BASE_QWORDS * sizeof(uint64_t));
+}
+
+#pragma GCC pop_options
+
+#endif
@@ -42,23 +42,47 @@
 #include "stdio.h"
 
 #include <openssl/evp.h>
+#include <pthread.h>
 
 
+// The SHA3-384 implementation, resolved once. With OpenSSL 3 an explicit
+// fetch: EVP_sha3_384() would make every EVP_DigestInit_ex look the
+// provider up again.
+static const EVP_MD* g_sha3_384_md = NULL;
+static pthread_once_t g_sha3_384_once = PTHREAD_ONCE_INIT;
+
+static void sha3_384_resolve(void)
+{
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    g_sha3_384_md = EVP_MD_fetch(NULL, "SHA3-384", NULL);
+#else
+    g_sha3_384_md = EVP_sha3_384();
+#endif
+}
+
+status_t sha3_384_init(void)
+{
+    pthread_once(&g_sha3_384_once, sha3_384_resolve);
+    return (g_sha3_384_md == NULL) ? E_SHA384_FAIL : SUCCESS;
+}
+
 /*
 Wrapper for SHA3-384 from openssl
 */
 void sha3_384(unsigned char* output, const unsigned char* input, uint64_t size){
-    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+    EVP_MD_CTX* ctx = NULL;
     unsigned int s;
     int check;
     status_t res = SUCCESS;
 
     // determine type
-    const EVP_MD* md = EVP_sha3_384();
-    if(md == NULL) res = E_SHA384_FAIL; CHECK_STATUS(res);
+    res = sha3_384_init(); CHECK_STATUS(res);
+
+    ctx = EVP_MD_CTX_new();
+    if(ctx == NULL) res = E_SHA384_FAIL; CHECK_STATUS(res);
 
     // DigistInit
-    check = EVP_DigestInit_ex(ctx, md, NULL);
+    check = EVP_DigestInit_ex(ctx, g_sha3_384_md, NULL);
     if(check == 0) res = E_SHA384_FAIL; CHECK_STATUS(res);
 
     // digist update
@@ -69,9 +93,9 @@ void sha3_384(unsigned char* output, const unsigned char* input, uint64_t size){
     check = EVP_DigestFinal(ctx, output, &s);
     if(check == 0) res = E_SHA384_FAIL; CHECK_STATUS(res);
 
+    EXIT:
     // clean up
     EVP_MD_CTX_free(ctx);
 
-    EXIT:
     DMSG("  Exit SHA3-384.\n");
 }
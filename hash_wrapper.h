@@ -58,6 +58,10 @@ typedef struct sha384_hash_s
 } sha384_hash_t;
 
 
+// Resolves the OpenSSL SHA3-384 implementation; sha3_384 does it on first
+// use. Thread-safe.
+status_t sha3_384_init(void);
+
 // Wrapper for OpenSSL SHA3-384
 void sha3_384(unsigned char* output, const unsigned char* input, uint64_t size);
 
@@ -0,0 +1,314 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "keccak_multi.h"
+#include "hash_wrapper.h"
+#include "dispatch.h"
+#include "string.h"
+
+// Multi-buffer Keccak-f[1600]: the same permutation as KeccakF1600 in
+// shake_prng.c, applied to KECCAK_LANES interleaved states.
+
+static const uint64_t keccak_round_constants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL,
+    0x8000000080008000ULL, 0x000000000000808BULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008AULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800AULL, 0x800000008000000AULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+// rho offsets, indexed by x + 5y
+static const uint32_t keccak_rho[25] = {
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14
+};
+
+#define ROL64(a, o) (((o) == 0) ? (a) : (((a) << (o)) ^ ((a) >> (64 - (o)))))
+
+void KeccakF1600_multi_portable(IN OUT keccak_multi_state_t *s)
+{
+    uint64_t B[25][KECCAK_LANES];
+    uint64_t C[5][KECCAK_LANES];
+    uint64_t D[KECCAK_LANES];
+
+    for (uint32_t round = 0; round < 24; round++)
+    {
+        // theta
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            for (uint32_t l = 0; l < KECCAK_LANES; l++)
+            {
+                C[x][l] = s->A[x][l] ^ s->A[x + 5][l] ^ s->A[x + 10][l] ^
+                          s->A[x + 15][l] ^ s->A[x + 20][l];
+            }
+        }
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            for (uint32_t l = 0; l < KECCAK_LANES; l++)
+            {
+                D[l] = C[(x + 4) % 5][l] ^ ROL64(C[(x + 1) % 5][l], 1);
+            }
+            for (uint32_t y = 0; y < 25; y += 5)
+            {
+                for (uint32_t l = 0; l < KECCAK_LANES; l++)
+                {
+                    s->A[x + y][l] ^= D[l];
+                }
+            }
+        }
+
+        // rho and pi: B[y, 2x + 3y] = ROL(A[x, y], rho[x, y])
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            for (uint32_t y = 0; y < 5; y++)
+            {
+                const uint32_t src = x + 5 * y;
+                const uint32_t dst = y + 5 * ((2 * x + 3 * y) % 5);
+                for (uint32_t l = 0; l < KECCAK_LANES; l++)
+                {
+                    B[dst][l] = ROL64(s->A[src][l], keccak_rho[src]);
+                }
+            }
+        }
+
+        // chi
+        for (uint32_t y = 0; y < 25; y += 5)
+        {
+            for (uint32_t x = 0; x < 5; x++)
+            {
+                for (uint32_t l = 0; l < KECCAK_LANES; l++)
+                {
+                    s->A[y + x][l] = B[y + x][l] ^
+                            ((~B[y + (x + 1) % 5][l]) & B[y + (x + 2) % 5][l]);
+                }
+            }
+        }
+
+        // iota
+        for (uint32_t l = 0; l < KECCAK_LANES; l++)
+        {
+            s->A[0][l] ^= keccak_round_constants[round];
+        }
+    }
+}
+
+void KeccakF1600_multi(IN OUT keccak_multi_state_t *s)
+{
+    bike_dispatch()->keccak_f1600_multi(s);
+}
+
+_INLINE_ uint64_t load64_le(IN const uint8_t *x)
+{
+    uint64_t u = 0;
+    for (int i = 7; i >= 0; i--)
+    {
+        u = (u << 8) | x[i];
+    }
+    return u;
+}
+
+_INLINE_ void store64_le(OUT uint8_t *x, IN uint64_t u)
+{
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        x[i] = (uint8_t)u;
+        u >>= 8;
+    }
+}
+
+// The single-state permutation on 64-bit words: the 25 words are loaded
+// once, kept in registers for the 24 rounds, and stored back. KeccakF1600
+// in shake_prng.c reads and writes the state a byte at a time on every step.
+void KeccakF1600_words(IN OUT void *s)
+{
+    uint8_t *bytes = (uint8_t *)s;
+    uint64_t A[25];
+    uint64_t B[25];
+    uint64_t C[5];
+    uint64_t D;
+
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        A[i] = load64_le(bytes + 8 * i);
+    }
+
+    for (uint32_t round = 0; round < 24; round++)
+    {
+        // theta
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
+        }
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            D = C[(x + 4) % 5] ^ ROL64(C[(x + 1) % 5], 1);
+            for (uint32_t y = 0; y < 25; y += 5)
+            {
+                A[x + y] ^= D;
+            }
+        }
+
+        // rho and pi
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            for (uint32_t y = 0; y < 5; y++)
+            {
+                const uint32_t src = x + 5 * y;
+                B[y + 5 * ((2 * x + 3 * y) % 5)] = ROL64(A[src], keccak_rho[src]);
+            }
+        }
+
+        // chi
+        for (uint32_t y = 0; y < 25; y += 5)
+        {
+            for (uint32_t x = 0; x < 5; x++)
+            {
+                A[y + x] = B[y + x] ^ ((~B[y + (x + 1) % 5]) & B[y + (x + 2) % 5]);
+            }
+        }
+
+        // iota
+        A[0] ^= keccak_round_constants[round];
+    }
+
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        store64_le(bytes + 8 * i, A[i]);
+    }
+}
+
+// XOR len bytes of every input into the leading bytes of its state.
+_INLINE_ void keccak_multi_xor_bytes(IN OUT keccak_multi_state_t *s,
+        IN const uint8_t *const in[KECCAK_LANES],
+        IN const uint64_t offset,
+        IN const uint32_t len)
+{
+    uint32_t i = 0;
+
+    for (; i + 8 <= len; i += 8)
+    {
+        for (uint32_t l = 0; l < KECCAK_LANES; l++)
+        {
+            s->A[i / 8][l] ^= load64_le(in[l] + offset + i);
+        }
+    }
+    for (; i < len; i++)
+    {
+        for (uint32_t l = 0; l < KECCAK_LANES; l++)
+        {
+            s->A[i / 8][l] ^= (uint64_t)in[l][offset + i] << (8 * (i % 8));
+        }
+    }
+}
+
+_INLINE_ void keccak_multi_xor_byte(IN OUT keccak_multi_state_t *s,
+        IN const uint32_t pos,
+        IN const uint8_t val)
+{
+    for (uint32_t l = 0; l < KECCAK_LANES; l++)
+    {
+        s->A[pos / 8][l] ^= (uint64_t)val << (8 * (pos % 8));
+    }
+}
+
+// Sponge absorb of KECCAK_LANES messages of the same length and padding.
+static void keccak_multi_absorb(OUT keccak_multi_state_t *s,
+        IN const uint32_t rate,
+        IN const uint8_t *const in[KECCAK_LANES],
+        IN const uint64_t inLen,
+        IN const uint8_t sfx)
+{
+    uint64_t offset = 0;
+
+    memset(s, 0, sizeof(*s));
+
+    while (inLen - offset >= rate)
+    {
+        keccak_multi_xor_bytes(s, in, offset, rate);
+        KeccakF1600_multi(s);
+        offset += rate;
+    }
+
+    keccak_multi_xor_bytes(s, in, offset, inLen - offset);
+    keccak_multi_xor_byte(s, inLen - offset, sfx);
+    keccak_multi_xor_byte(s, rate - 1, 0x80);
+    KeccakF1600_multi(s);
+}
+
+void keccak_multi_extract(OUT uint8_t out[KECCAK_LANES][SHAKE256_STATE_SIZE],
+        IN const keccak_multi_state_t *s,
+        IN const uint32_t len)
+{
+    for (uint32_t l = 0; l < KECCAK_LANES; l++)
+    {
+        for (uint32_t i = 0; i < len; i++)
+        {
+            out[l][i] = (uint8_t)(s->A[i / 8][l] >> (8 * (i % 8)));
+        }
+    }
+}
+
+void shake256_multi_init(IN const uint8_t *const in[KECCAK_LANES],
+        IN const uint64_t inLen,
+        OUT keccak_multi_state_t *s)
+{
+    keccak_multi_absorb(s, SHAKE256_BLOCK_SIZE, in, inLen, 0x1F);
+}
+
+void sha3_384_multi(OUT uint8_t *const output[KECCAK_LANES],
+        IN const uint8_t *const input[KECCAK_LANES],
+        IN const uint64_t size)
+{
+    keccak_multi_state_t s;
+    uint8_t block[KECCAK_LANES][SHAKE256_STATE_SIZE];
+
+    keccak_multi_absorb(&s, SHA3_384_BLOCK_SIZE, input, size, 0x06);
+    keccak_multi_extract(block, &s, SHA384_HASH_SIZE);
+
+    for (uint32_t l = 0; l < KECCAK_LANES; l++)
+    {
+        memcpy(output[l], block[l], SHA384_HASH_SIZE);
+    }
+
+    DMSG("  Exit SHA3-384 multi.\n");
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef __KECCAK_MULTI_H_INCLUDED__
+#define __KECCAK_MULTI_H_INCLUDED__
+
+#include "types.h"
+#include "shake_prng.h"
+
+// Number of independent Keccak states processed together (2 or 4).
+// The states are interleaved lane by lane, so every step of the permutation
+// is a loop over KECCAK_LANES words that the compiler maps to SIMD registers.
+#ifndef KECCAK_LANES
+#define KECCAK_LANES 4
+#endif
+
+#define SHA3_384_BLOCK_SIZE 104ULL
+
+//////////////////////////////
+//        Types
+/////////////////////////////
+
+typedef struct keccak_multi_state_s
+{
+    // A[x + 5y][l] is the 64-bit word (x, y) of state l.
+    uint64_t A[25][KECCAK_LANES];
+} keccak_multi_state_t;
+
+//////////////////////////////
+//        Methods
+/////////////////////////////
+
+// Keccak-f[1600] on all states, with the backend selected at run time
+// (dispatch.h).
+void KeccakF1600_multi(IN OUT keccak_multi_state_t *s);
+
+typedef void (*keccak_multi_permute_t)(IN OUT keccak_multi_state_t *s);
+
+void KeccakF1600_multi_portable(IN OUT keccak_multi_state_t *s);
+
+// Four states are exactly one 256-bit register per state word.
+#if !defined(BIKE_PORTABLE) && defined(__x86_64__) && (KECCAK_LANES == 4)
+#define KECCAK_HAVE_AVX2
+void KeccakF1600_multi_avx2(IN OUT keccak_multi_state_t *s);
+#endif
+
+// The single-state permutation on a SHAKE256_STATE_SIZE byte state, as
+// bound in the dispatch table: KeccakF1600 (shake_prng.c) is the portable
+// reference, KeccakF1600_words the word-oriented version.
+typedef void (*keccak_permute_t)(IN OUT void *s);
+
+void KeccakF1600_words(IN OUT void *s);
+
+// Copy the first len bytes of every state (the squeezed block) to out[l].
+void keccak_multi_extract(OUT uint8_t out[KECCAK_LANES][SHAKE256_STATE_SIZE],
+        IN const keccak_multi_state_t *s,
+        IN const uint32_t len);
+
+// Absorb KECCAK_LANES inputs of the same length; afterwards the first
+// SHAKE256_BLOCK_SIZE bytes of every state are the first output block,
+// exactly as after shake256_init.
+void shake256_multi_init(IN const uint8_t *const in[KECCAK_LANES],
+        IN const uint64_t inLen,
+        OUT keccak_multi_state_t *s);
+
+// SHA3-384 of KECCAK_LANES messages of the same size.
+void sha3_384_multi(OUT uint8_t *const output[KECCAK_LANES],
+        IN const uint8_t *const input[KECCAK_LANES],
+        IN const uint64_t size);
+
+#endif //__KECCAK_MULTI_H_INCLUDED__
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "keccak_multi.h"
+
+#ifdef KECCAK_HAVE_AVX2
+
+#include <immintrin.h>
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+static const uint64_t keccak_round_constants_avx2[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808AULL,
+    0x8000000080008000ULL, 0x000000000000808BULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008AULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000AULL,
+    0x000000008000808BULL, 0x800000000000008BULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800AULL, 0x800000008000000AULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+// rho offsets, indexed by x + 5y
+static const uint32_t keccak_rho_avx2[25] = {
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14
+};
+
+// Shift counts of 64 and more give zero, so o = 0 needs no special case.
+_INLINE_ __m256i rol64_avx2(IN const __m256i a, IN const uint32_t o)
+{
+    return _mm256_or_si256(_mm256_sll_epi64(a, _mm_cvtsi32_si128((int)o)),
+                           _mm256_srl_epi64(a, _mm_cvtsi32_si128((int)(64 - o))));
+}
+
+// The steps of KeccakF1600_multi_portable with one register per state word.
+void KeccakF1600_multi_avx2(IN OUT keccak_multi_state_t *s)
+{
+    __m256i A[25];
+    __m256i B[25];
+    __m256i C[5];
+
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        A[i] = _mm256_loadu_si256((const __m256i*)s->A[i]);
+    }
+
+    for (uint32_t round = 0; round < 24; round++)
+    {
+        // theta
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            C[x] = _mm256_xor_si256(_mm256_xor_si256(A[x], A[x + 5]),
+                    _mm256_xor_si256(_mm256_xor_si256(A[x + 10], A[x + 15]), A[x + 20]));
+        }
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            const __m256i D = _mm256_xor_si256(C[(x + 4) % 5], rol64_avx2(C[(x + 1) % 5], 1));
+            for (uint32_t y = 0; y < 25; y += 5)
+            {
+                A[x + y] = _mm256_xor_si256(A[x + y], D);
+            }
+        }
+
+        // rho and pi: B[y, 2x + 3y] = ROL(A[x, y], rho[x, y])
+        for (uint32_t x = 0; x < 5; x++)
+        {
+            for (uint32_t y = 0; y < 5; y++)
+            {
+                const uint32_t src = x + 5 * y;
+                B[y + 5 * ((2 * x + 3 * y) % 5)] = rol64_avx2(A[src], keccak_rho_avx2[src]);
+            }
+        }
+
+        // chi
+        for (uint32_t y = 0; y < 25; y += 5)
+        {
+            for (uint32_t x = 0; x < 5; x++)
+            {
+                A[y + x] = _mm256_xor_si256(B[y + x],
+                        _mm256_andnot_si256(B[y + (x + 1) % 5], B[y + (x + 2) % 5]));
+            }
+        }
+
+        // iota
+        A[0] = _mm256_xor_si256(A[0], _mm256_set1_epi64x((long long)keccak_round_constants_avx2[round]));
+    }
+
+    for (uint32_t i = 0; i < 25; i++)
+    {
+        _mm256_storeu_si256((__m256i*)s->A[i], A[i]);
+    }
+}
+
+#pragma GCC pop_options
+
+#endif //KECCAK_HAVE_AVX2
@@ -37,15 +37,24 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
+#include <openssl/evp.h>
 
 #include "hash_wrapper.h"
 #include "openssl_utils.h"
-#include "ntl.h"
+#include "gf2x.h"
 #include "decode.h"
+#include "decode_parallel.h"
 #include "sampling.h"
 #include "kem.h"
 #include "conversions.h"
 #include "shake_prng.h"
+#include "keccak_multi.h"
+#include "kem_stages.h"
+#include "dispatch.h"
+#ifndef BIKE_LOW_MEM
+#include "ntl.h"
+#endif
 
 // Function H. It uses the extract-then-expand paradigm based on SHA384 and
 // AES256-CTR PRNG to produce e from m.
@@ -71,15 +80,16 @@ _INLINE_ status_t functionH(
 }
 
 // Function L. Computes L(e0 || e1)
+// e_split is scratch of 2*R_SIZE bytes.
 _INLINE_ status_t functionL(
         OUT uint8_t * output,
-        IN const uint8_t * e)
+        IN const uint8_t * e,
+        OUT uint8_t * e_split)
 {
     status_t res = SUCCESS;
     uint8_t hash_value[SHA384_HASH_SIZE] = {0};
-    uint8_t e_split[2 * R_SIZE] = {0};
 
-    ntl_split_polynomial(e_split, &e_split[R_SIZE], e);
+    gf2x_split(e_split, &e_split[R_SIZE], e);
 
     // select hash function
     sha3_384(hash_value, e_split, 2*R_SIZE);
@@ -90,18 +100,19 @@ _INLINE_ status_t functionL(
     return res;
 }
 
-// Function K. Computes K(m || c0 || c1).
+// Function K. Computes K(m || c0 || c1); tmp1 is scratch of
+// 2*ELL_SIZE + R_SIZE bytes.
 _INLINE_ status_t functionK(
         OUT uint8_t * output,
         IN const uint8_t * m,
         IN const uint8_t * c0,
-        IN const uint8_t * c1)
+        IN const uint8_t * c1,
+        OUT uint8_t * tmp1)
 {
     status_t res = SUCCESS;
     sha384_hash_t large_hash = {0};
 
     // preparing buffer with: [m || c0 || c1]
-    uint8_t tmp1[ELL_SIZE + 2*R_SIZE] = {0};
     memcpy(tmp1, m, ELL_SIZE);
     memcpy(tmp1 + ELL_SIZE, c0, R_SIZE);
     memcpy(tmp1 + ELL_SIZE + R_SIZE, c1, ELL_SIZE);
@@ -115,31 +126,89 @@ _INLINE_ status_t functionK(
     return res;
 }
 
-_INLINE_ status_t compute_syndrome(OUT syndrome_t* syndrome,
-        IN const ct_t* ct,
-        IN const sk_t* sk)
+#ifdef BIKE_LOW_MEM
+
+// a64 = a mod (x^R_BITS - 1): fold the padding bits of the last byte.
+_INLINE_ void load_reduced(OUT uint64_t a64[R_QWORDS],
+        IN const uint8_t a[R_SIZE])
+{
+    memset(a64, 0, R_QWORDS * sizeof(uint64_t));
+    memcpy(a64, a, R_SIZE);
+    a64[0] ^= a64[R_QWORDS - 1] >> (R_BITS % 64);
+    a64[R_QWORDS - 1] &= MASK(R_BITS % 64);
+}
+
+// res = a*b for b of weight at most T1 (e1 of encaps), as a sum of
+// rotations of a: a few KB of stack instead of a Karatsuba product.
+_INLINE_ void mod_mul_sparse(OUT uint8_t res[R_SIZE],
+        IN const uint8_t a[R_SIZE],
+        IN const uint8_t b[R_SIZE])
+{
+    uint64_t a64[R_QWORDS];
+    uint64_t r64[R_QWORDS];
+    uint32_t wlist[T1];
+    uint32_t weight = 0;
+
+    for (uint32_t i = 0; (i < R_BITS) && (weight < T1); i++)
+    {
+        if ((b[i / 8] >> (i % 8)) & 1)
+        {
+            wlist[weight++] = i;
+        }
+    }
+
+    load_reduced(a64, a);
+    gf2x_mod_mul_sparse(r64, a64, wlist, weight);
+    memcpy(res, r64, R_SIZE);
+}
+
+// Computes the bit-packed syndrome ws->s = c0*h0 from the support of h0.
+_INLINE_ status_t compute_syndrome_packed(IN const ct_t* ct,
+        IN const uint32_t h0_compact[DV],
+        IN OUT bike_ws_t* ws)
+{
+    status_t res = SUCCESS;
+
+    load_reduced(ws->c0, ct->val0);
+    gf2x_mod_mul_sparse(ws->s, ws->c0, h0_compact, DV);
+
+    DMSG("  Exit compute_syndrome.\n");
+
+    return res;
+}
+
+#else
+
+// Computes ws->syndrome.
+_INLINE_ status_t compute_syndrome(IN const ct_t* ct,
+        IN const sk_t* sk,
+        IN OUT bike_ws_t* ws)
 {
     status_t res = SUCCESS;
-    uint8_t s_tmp_bytes[R_BITS] = {0};
-    uint8_t s0[R_SIZE] = {0};
 
     // syndrome: s = c0*h0
-    ntl_mod_mul(s0, sk->val0, ct->val0);
+    gf2x_mod_mul_ws(ws->s0, sk->val0, ct->val0, &ws->mul);
 
-    // store the syndrome in a bit array
-    convertByteToBinary(s_tmp_bytes, s0, R_BITS);
-    transpose(syndrome->raw, s_tmp_bytes);
+    // store the syndrome in a bit array (the conversion only sets the ones)
+    memset(ws->s_bytes, 0, R_BITS);
+    convertByteToBinary(ws->s_bytes, ws->s0, R_BITS);
+    transpose(ws->syndrome.raw, ws->s_bytes);
 
     DMSG("  Exit compute_syndrome.\n");
 
     return res;
 }
 
+#endif //BIKE_LOW_MEM
+
 ////////////////////////////////////////////////////////////////
 //The three APIs below (keypair, enc, dec) are defined by NIST:
 //In addition there are two KAT versions of this API as defined.
 ////////////////////////////////////////////////////////////////
-int crypto_kem_keypair(OUT unsigned char *pk, OUT unsigned char *sk)
+//Keygenerate from the given entropy seeds.
+int crypto_kem_keypair_seeds(OUT unsigned char *pk,
+        OUT unsigned char *sk,
+        IN const double_seed_t* seeds)
 {
     //Convert to these implementation types
     sk_t* l_sk = (sk_t*)sk;
@@ -148,13 +217,8 @@ int crypto_kem_keypair(OUT unsigned char *pk, OUT unsigned char *sk)
     // return code
     status_t res = SUCCESS;
 
-    //For NIST DRBG_CTR
-    double_seed_t seeds = {0};
     shake256_prng_state_t h_prng_state = {0};
 
-    //Get the entropy seeds
-    get_seeds(&seeds, KEYGEN_SEEDS);
-
     // sk = (h0, h1, sigma)
     uint8_t * h0 = l_sk->val0;
     uint8_t * h1 = l_sk->val1;
@@ -165,18 +229,20 @@ int crypto_kem_keypair(OUT unsigned char *pk, OUT unsigned char *sk)
     DMSG("  Enter crypto_kem_keypair.\n");
     DMSG("    Calculating the secret key.\n");
 
-    shake256_init(seeds.s1.raw, ELL_SIZE, &h_prng_state);
-    res = generate_sparse_rep_keccak(h0, DV, R_BITS, &h_prng_state); CHECK_STATUS(res);
-    res = generate_sparse_rep_keccak(h1, DV, R_BITS, &h_prng_state); CHECK_STATUS(res);
+    BIKE_STAGE(BIKE_STAGE_KEYGEN_SAMPLE,
+        shake256_init(seeds->s1.raw, ELL_SIZE, &h_prng_state);
+        res = generate_sparse_rep_keccak(h0, DV, R_BITS, &h_prng_state); CHECK_STATUS(res);
+        res = generate_sparse_rep_keccak(h1, DV, R_BITS, &h_prng_state); CHECK_STATUS(res);
+    )
 
     // use the second seed as sigma
-    memcpy(sigma, seeds.s2.raw, ELL_SIZE);
+    memcpy(sigma, seeds->s2.raw, ELL_SIZE);
 
     DMSG("    Calculating the public key.\n");
 
     // pk = (1, h1*h0^(-1)), the first pk component (1) is implicitly assumed
-    ntl_mod_inv(inv_h0, h0);
-    ntl_mod_mul(l_pk->val, h1, inv_h0);
+    BIKE_STAGE(BIKE_STAGE_KEYGEN_INV, gf2x_mod_inv(inv_h0, h0); )
+    BIKE_STAGE(BIKE_STAGE_KEYGEN_MUL, gf2x_mod_mul(l_pk->val, h1, inv_h0); )
 
     EDMSG("h0: "); print((uint64_t*)l_sk->val0, R_BITS);
     EDMSG("h1: "); print((uint64_t*)l_sk->val1, R_BITS);
@@ -188,12 +254,22 @@ int crypto_kem_keypair(OUT unsigned char *pk, OUT unsigned char *sk)
     return res;
 }
 
-//Encapsulate - pk is the public key,
-//              ct is a key encapsulation message (ciphertext),
-//              ss is the shared secret.
-int crypto_kem_enc(OUT unsigned char *ct,
+int crypto_kem_keypair(OUT unsigned char *pk, OUT unsigned char *sk)
+{
+    //For NIST DRBG_CTR
+    double_seed_t seeds = {0};
+
+    //Get the entropy seeds
+    get_seeds(&seeds, KEYGEN_SEEDS);
+
+    return crypto_kem_keypair_seeds(pk, sk, &seeds);
+}
+
+//Encapsulate from the given entropy seeds.
+int crypto_kem_enc_seeds(OUT unsigned char *ct,
         OUT unsigned char *ss,
-        IN  const unsigned char *pk)
+        IN  const unsigned char *pk,
+        IN const double_seed_t* seeds)
 {
     DMSG("  Enter crypto_kem_enc.\n");
 
@@ -204,12 +280,6 @@ int crypto_kem_enc(OUT unsigned char *ct,
     ct_t* l_ct = (ct_t*)ct;
     ss_t* l_ss = (ss_t*)ss;
 
-    //For NIST DRBG_CTR.
-    double_seed_t seeds = {0};
-
-    //Get the entropy seeds.
-    get_seeds(&seeds, ENCAPS_SEEDS);
-
     // quantity m:
     uint8_t m[ELL_SIZE] = {0};
 
@@ -218,26 +288,43 @@ int crypto_kem_enc(OUT unsigned char *ct,
     uint8_t e0[R_SIZE] = {0};
     uint8_t e1[R_SIZE] = {0};
 
-    // temporary buffer:
+    // temporary buffers:
     uint8_t tmp[ELL_SIZE] = {0};
+    uint8_t e_split[2*R_SIZE] = {0};
+    uint8_t mc0c1[2*ELL_SIZE + R_SIZE] = {0};
 
     //random data generator; Using seed s1
-    memcpy(m, seeds.s1.raw, ELL_SIZE);
+    memcpy(m, seeds->s1.raw, ELL_SIZE);
 
     // (e0, e1) = H(m)
-    functionH(e, m);
-    ntl_split_polynomial(e0, e1, e);
+    BIKE_STAGE(BIKE_STAGE_ENC_H,
+        functionH(e, m);
+        gf2x_split(e0, e1, e);
+    )
 
     // ct = (c0, c1) = (e0 + e1*h, L(e0, e1) \XOR m)
-    ntl_mod_mul(l_ct->val0, e1, l_pk->val);
-    ntl_add(l_ct->val0, l_ct->val0, e0);
-    functionL(tmp, e);
-    for (uint32_t i = 0; i < ELL_SIZE; i++)
-        l_ct->val1[i] = tmp[i] ^ m[i];
+#ifdef BIKE_LOW_MEM
+    BIKE_STAGE(BIKE_STAGE_ENC_MUL,
+        mod_mul_sparse(l_ct->val0, l_pk->val, e1);
+        gf2x_mod_add(l_ct->val0, l_ct->val0, e0);
+    )
+#else
+    BIKE_STAGE(BIKE_STAGE_ENC_MUL,
+        gf2x_mod_mul(l_ct->val0, e1, l_pk->val);
+        gf2x_mod_add(l_ct->val0, l_ct->val0, e0);
+    )
+#endif
+    BIKE_STAGE(BIKE_STAGE_ENC_L,
+        functionL(tmp, e, e_split);
+        for (uint32_t i = 0; i < ELL_SIZE; i++)
+            l_ct->val1[i] = tmp[i] ^ m[i];
+    )
 
     // Function K:
     //shared secret =  K(m || c0 || c1)
-    functionK(l_ss->raw, m, l_ct->val0, l_ct->val1);
+    BIKE_STAGE(BIKE_STAGE_ENC_K,
+        functionK(l_ss->raw, m, l_ct->val0, l_ct->val1, mc0c1);
+    )
 
     EDMSG("ss: "); print((uint64_t*)l_ss->raw, sizeof(*l_ss)*8);
 
@@ -247,12 +334,83 @@ int crypto_kem_enc(OUT unsigned char *ct,
     return res;
 }
 
-//Decapsulate - ct is a key encapsulation message (ciphertext),
-//              sk is the private key,
-//              ss is the shared secret
-int crypto_kem_dec(OUT unsigned char *ss,
+//Encapsulate - pk is the public key,
+//              ct is a key encapsulation message (ciphertext),
+//              ss is the shared secret.
+int crypto_kem_enc(OUT unsigned char *ct,
+        OUT unsigned char *ss,
+        IN  const unsigned char *pk)
+{
+    //For NIST DRBG_CTR.
+    double_seed_t seeds = {0};
+
+    //Get the entropy seeds.
+    get_seeds(&seeds, ENCAPS_SEEDS);
+
+    return crypto_kem_enc_seeds(ct, ss, pk, &seeds);
+}
+
+// Steps 3-6 of decapsulation: given the decoded error e_prime, re-encrypt
+// and derive the shared secret (K(sigma || c0 || c1) on mismatch).
+_INLINE_ void decaps_shared_secret(OUT ss_t* l_ss,
+        IN const ct_t* l_ct,
+        IN const sk_t* l_sk,
+        IN const uint8_t e_prime[N_SIZE],
+        IN OUT bike_ws_t* ws)
+{
+    int failed = 0;
+
+    uint8_t* e_recomputed = ws->e_recomputed;
+    uint8_t Le0e1[ELL_SIZE] = {0};
+    uint8_t m_prime[ELL_SIZE] = {0};
+
+    // Step 3. compute L(e0 || e1)
+    BIKE_STAGE(BIKE_STAGE_DEC_L,
+        functionL(Le0e1, e_prime, ws->e_split);
+
+        // Step 4. retrieve m' = c1 \xor L(e0 || e1)
+        for(uint32_t i = 0; i < ELL_SIZE; i++)
+        {
+            m_prime[i] = l_ct->val1[i] ^ Le0e1[i];
+        }
+    )
+
+    // Step 5. (e0, e1) = H(m)
+    BIKE_STAGE(BIKE_STAGE_DEC_H,
+        functionH(e_recomputed, m_prime);
+
+        if (!safe_cmp(e_recomputed, e_prime, N_SIZE))
+        {
+            DMSG("recomputed error vector does not match decoded error vector\n");
+            failed = 1;
+        }
+    )
+
+    // Step 6. compute shared secret k = K()
+    BIKE_STAGE(BIKE_STAGE_DEC_K,
+        if (failed) {
+            // shared secret = K(sigma || c0 || c1)
+            functionK(l_ss->raw, l_sk->sigma, l_ct->val0, l_ct->val1, ws->mc0c1);
+        }
+        else
+        {
+           // shared secret = K(m' || c0 || c1)
+            functionK(l_ss->raw, m_prime, l_ct->val0, l_ct->val1, ws->mc0c1);
+        }
+    )
+}
+
+//Decapsulate with the temporaries in the workspace ws and the given
+//decoder (DECODER_BGF or DECODER_BACKFLIP), decoding BGF on the workers of
+//pool unless it is NULL; h0_compact and h1_compact are the supports of sk.
+_INLINE_ int decaps_compact(OUT unsigned char *ss,
         IN const unsigned char *ct,
-        IN const unsigned char *sk)
+        IN const unsigned char *sk,
+        IN uint32_t h0_compact[DV],
+        IN uint32_t h1_compact[DV],
+        IN bike_decode_pool_t *pool,
+        IN const uint32_t decoder,
+        IN OUT bike_ws_t *ws)
 {
     DMSG("  Enter crypto_kem_dec.\n");
     status_t res = SUCCESS;
@@ -262,78 +420,378 @@ int crypto_kem_dec(OUT unsigned char *ss,
     const ct_t* l_ct = (ct_t*)ct;
     ss_t* l_ss = (ss_t*)ss;
 
-    int failed = 0;
+    DMSG("  Computing s.\n");
 
-    // for NIST DRBG_CTR
-    double_seed_t seeds = {0};
-  
-    uint8_t e_recomputed[N_SIZE] = {0};
+#ifdef BIKE_LOW_MEM
+    // Step 1. computing the bit-packed syndrome:
+    BIKE_STAGE(BIKE_STAGE_DEC_SYNDROME,
+        res = compute_syndrome_packed(l_ct, h0_compact, ws); CHECK_STATUS(res);
+    )
 
-    uint8_t Le0e1[ELL_SIZE + 2*R_SIZE] = {0};
-    uint8_t m_prime[ELL_SIZE] = {0};
+    // Step 2. decoding, straight to e':
+    DMSG("  Decoding.\n");
+    (void)pool;
+    (void)decoder;
+    BIKE_STAGE(BIKE_STAGE_DEC_DECODE,
+        BGF_decoder_packed_ws(ws->e_prime, (uint8_t*)ws->s, h0_compact, h1_compact, ws);
+    )
+#else
+       // Step 1. computing syndrome:
+    BIKE_STAGE(BIKE_STAGE_DEC_SYNDROME,
+        res = compute_syndrome(l_ct, l_sk, ws); CHECK_STATUS(res);
+    )
 
-    uint32_t h0_compact[DV] = {0};
-    uint32_t h1_compact[DV] = {0};
+    // Step 2. decoding:
+    DMSG("  Decoding.\n");
+    BIKE_STAGE(BIKE_STAGE_DEC_DECODE,
+        if (decoder == DECODER_BACKFLIP)
+        {
+            backflip_decoder_ws(ws->e, ws->syndrome.raw, h0_compact, h1_compact, ws);
+        }
+        else if (pool != NULL)
+        {
+            BGF_decoder_parallel_ws(ws->e, ws->syndrome.raw, h0_compact, h1_compact, pool, ws);
+        }
+        else
+        {
+            BGF_decoder_ws(ws->e, ws->syndrome.raw, h0_compact, h1_compact, ws);
+        }
+    )
+
+    // the conversion ORs into its output
+    memset(ws->e_prime, 0, N_SIZE);
+    convertBinaryToByte(ws->e_prime, ws->e, 2*R_BITS);
+#endif
+
+    // Steps 3-6. re-encrypt and derive the shared secret; a decoding
+    // failure is not branched on, it fails the re-encryption check
+    decaps_shared_secret(l_ss, l_ct, l_sk, ws->e_prime, ws);
 
-    uint8_t e_prime[N_SIZE] = {0};
-    uint8_t e_twoprime[R_BITS*2] = {0};
-   
-    uint8_t e_tmp1[R_BITS*2] = {0};
-    uint8_t e_tmp2[N_SIZE] = {0};
+    EXIT:
 
-    uint8_t e0rand[R_SIZE] = {0};
-    uint8_t e1rand[R_SIZE] = {0};
+    DMSG("  Exit crypto_kem_dec.\n");
+    return res;
+}
 
-    int rc;
+_INLINE_ int decaps(OUT unsigned char *ss,
+        IN const unsigned char *ct,
+        IN const unsigned char *sk,
+        IN bike_decode_pool_t *pool,
+        IN const uint32_t decoder,
+        IN OUT bike_ws_t *ws)
+{
+    const sk_t* l_sk = (sk_t*)sk;
+    uint32_t h0_compact[DV] = {0};
+    uint32_t h1_compact[DV] = {0};
 
     DMSG("  Converting to compact rep.\n");
     convert2compact(h0_compact, l_sk->val0);
     convert2compact(h1_compact, l_sk->val1);
 
-    DMSG("  Computing s.\n");
-    syndrome_t syndrome;
+    return decaps_compact(ss, ct, sk, h0_compact, h1_compact, pool, decoder, ws);
+}
 
-       // Step 1. computing syndrome:
-    res = compute_syndrome(&syndrome, l_ct, l_sk); CHECK_STATUS(res);
+//Decapsulate with the temporaries in the workspace ws.
+int crypto_kem_dec_ws(OUT unsigned char *ss,
+        IN const unsigned char *ct,
+        IN const unsigned char *sk,
+        IN OUT bike_ws_t *ws)
+{
+    return decaps(ss, ct, sk, NULL, DECODER, ws);
+}
 
-    // Step 2. decoding:
-    DMSG("  Decoding.\n");
-    rc = BGF_decoder(e_tmp1, syndrome.raw, h0_compact, h1_compact);
+//Decapsulate - ct is a key encapsulation message (ciphertext),
+//              sk is the private key,
+//              ss is the shared secret
+int crypto_kem_dec(OUT unsigned char *ss,
+        IN const unsigned char *ct,
+        IN const unsigned char *sk)
+{
+    bike_ws_t* ws = bike_ws_thread();
+    if (ws == NULL)
+    {
+        return E_ALLOCATION_FAILURE;
+    }
 
-    convertBinaryToByte(e_prime, e_tmp1, 2*R_BITS);
+    return crypto_kem_dec_ws(ss, ct, sk, ws);
+}
 
-    // Step 3. compute L(e0 || e1)
-    functionL(Le0e1, e_prime);
+#ifndef BIKE_LOW_MEM
+//Decapsulate with the decoder running on the workers of pool.
+int crypto_kem_dec_parallel(OUT unsigned char *ss,
+        IN const unsigned char *ct,
+        IN const unsigned char *sk,
+        IN bike_decode_pool_t *pool)
+{
+    bike_ws_t* ws = bike_ws_thread();
+    if (ws == NULL)
+    {
+        return E_ALLOCATION_FAILURE;
+    }
+
+    return decaps(ss, ct, sk, pool, DECODER, ws);
+}
 
-    // Step 4. retrieve m' = c1 \xor L(e0 || e1)
-    for(uint32_t i = 0; i < ELL_SIZE; i++)
+//Decapsulate with the Backflip decoder, whatever DECODER selects.
+int crypto_kem_dec_backflip(OUT unsigned char *ss,
+        IN const unsigned char *ct,
+        IN const unsigned char *sk)
+{
+    bike_ws_t* ws = bike_ws_thread();
+    if (ws == NULL)
     {
-        m_prime[i] = l_ct->val1[i] ^ Le0e1[i];
+        return E_ALLOCATION_FAILURE;
     }
 
-    // Step 5. (e0, e1) = H(m)
-    functionH(e_recomputed, m_prime);
+    return decaps(ss, ct, sk, NULL, DECODER_BACKFLIP, ws);
+}
+#endif
+
+
+#ifndef BIKE_LOW_MEM
+//Batched decapsulate - ct[i] are n key encapsulation messages under the
+//              private key sk, ss[i] receives the shared secret of ct[i].
+int crypto_kem_dec_batch(OUT unsigned char *ss[],
+        IN const unsigned char *const ct[],
+        IN const unsigned char *sk,
+        IN const uint32_t n)
+{
+    DMSG("  Enter crypto_kem_dec_batch.\n");
+    status_t res = SUCCESS;
+
+    const sk_t* l_sk = (sk_t*)sk;
+
+    uint32_t h0_compact[DV] = {0};
+    uint32_t h1_compact[DV] = {0};
 
-    if (!safe_cmp(e_recomputed, e_prime, N_SIZE))
+    bike_ws_t* ws = bike_ws_thread();
+    if (ws == NULL)
     {
-        DMSG("recomputed error vector does not match decoded error vector\n");
-        failed = 1;
+        ERR(E_ALLOCATION_FAILURE);
     }
 
-    // Step 6. compute shared secret k = K()
-    if (failed) {
-        // shared secret = K(sigma || c0 || c1)
-        functionK(l_ss->raw, l_sk->sigma, l_ct->val0, l_ct->val1);
+    // the key is expanded once for the whole batch
+    DMSG("  Converting to compact rep.\n");
+    convert2compact(h0_compact, l_sk->val0);
+    convert2compact(h1_compact, l_sk->val1);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        res = (status_t)decaps_compact(ss[i], ct[i], sk, h0_compact, h1_compact, NULL, DECODER, ws);
+        CHECK_STATUS(res);
+    }
+
+    EXIT:
+    DMSG("  Exit crypto_kem_dec_batch.\n");
+    return res;
+}
+#endif //BIKE_LOW_MEM
+
+// Scratch of crypto_kem_enc_batch, shared by all groups of KECCAK_LANES
+// encapsulations. Lanes past n (last group) run on a copy of lane 0.
+typedef struct enc_batch_scratch_s
+{
+    double_seed_t seeds[KECCAK_LANES];
+    uint8_t m[KECCAK_LANES][ELL_SIZE];
+    uint8_t e[KECCAK_LANES][N_SIZE];
+    uint8_t e0[KECCAK_LANES][R_SIZE];
+    uint8_t e1[KECCAK_LANES][R_SIZE];
+    uint8_t e_split[KECCAK_LANES][2*R_SIZE];
+    uint8_t hash[KECCAK_LANES][SHA384_HASH_SIZE];
+    uint8_t mc0c1[KECCAK_LANES][ELL_SIZE + 2*R_SIZE];
+    ct_t ct[KECCAK_LANES];
+} enc_batch_scratch_t;
+
+//Batched encapsulate - pk[i] are n public keys (not necessarily distinct),
+//              ct[i] and ss[i] receive the output of encapsulating to pk[i].
+int crypto_kem_enc_batch(OUT unsigned char *ct[],
+        OUT unsigned char *ss[],
+        IN const unsigned char *const pk[],
+        IN const uint32_t n)
+{
+    DMSG("  Enter crypto_kem_enc_batch.\n");
+    status_t res = SUCCESS;
+
+    keccak_multi_state_t prng_state;
+
+    const uint8_t* m_in[KECCAK_LANES];
+    uint8_t* e_out[KECCAK_LANES];
+    const uint8_t* split_in[KECCAK_LANES];
+    const uint8_t* mc0c1_in[KECCAK_LANES];
+    uint8_t* hash_out[KECCAK_LANES];
+
+    enc_batch_scratch_t* w = (enc_batch_scratch_t*)malloc(sizeof(enc_batch_scratch_t));
+    if (w == NULL)
+    {
+        ERR(E_ALLOCATION_FAILURE);
+    }
+
+    for (uint32_t l = 0; l < KECCAK_LANES; l++)
+    {
+        m_in[l] = w->m[l];
+        e_out[l] = w->e[l];
+        split_in[l] = w->e_split[l];
+        mc0c1_in[l] = w->mc0c1[l];
+        hash_out[l] = w->hash[l];
     }
-    else
+
+    for (uint32_t first = 0; first < n; first += KECCAK_LANES)
     {
-       // shared secret = K(m' || c0 || c1)
-        functionK(l_ss->raw, m_prime, l_ct->val0, l_ct->val1);
+        const uint32_t lanes = (n - first < KECCAK_LANES) ? (n - first) : KECCAK_LANES;
+
+        //Get the entropy seeds, in the order of sequential calls.
+        for (uint32_t l = 0; l < lanes; l++)
+        {
+            get_seeds(&w->seeds[l], ENCAPS_SEEDS);
+        }
+        for (uint32_t l = lanes; l < KECCAK_LANES; l++)
+        {
+            w->seeds[l] = w->seeds[0];
+        }
+
+        //random data generator; Using seed s1
+        for (uint32_t l = 0; l < KECCAK_LANES; l++)
+        {
+            memcpy(w->m[l], w->seeds[l].s1.raw, ELL_SIZE);
+        }
+
+        // (e0, e1) = H(m)
+        shake256_multi_init(m_in, ELL_SIZE, &prng_state);
+        res = generate_sparse_rep_keccak_multi(e_out, T1, N_BITS, &prng_state); CHECK_STATUS(res);
+
+        // c0 = e0 + e1*h
+        for (uint32_t l = 0; l < lanes; l++)
+        {
+            gf2x_split(w->e0[l], w->e1[l], w->e[l]);
+            gf2x_mod_mul(w->ct[l].val0, w->e1[l], ((const pk_t*)pk[first + l])->val);
+            gf2x_mod_add(w->ct[l].val0, w->ct[l].val0, w->e0[l]);
+        }
+        for (uint32_t l = lanes; l < KECCAK_LANES; l++)
+        {
+            w->ct[l] = w->ct[0];
+        }
+
+        // c1 = L(e0, e1) \XOR m
+        for (uint32_t l = 0; l < KECCAK_LANES; l++)
+        {
+            gf2x_split(w->e_split[l], &w->e_split[l][R_SIZE], w->e[l]);
+        }
+        sha3_384_multi(hash_out, split_in, 2*R_SIZE);
+        for (uint32_t l = 0; l < KECCAK_LANES; l++)
+        {
+            for (uint32_t i = 0; i < ELL_SIZE; i++)
+                w->ct[l].val1[i] = w->hash[l][i] ^ w->m[l][i];
+        }
+
+        //shared secret =  K(m || c0 || c1)
+        for (uint32_t l = 0; l < KECCAK_LANES; l++)
+        {
+            memcpy(w->mc0c1[l], w->m[l], ELL_SIZE);
+            memcpy(w->mc0c1[l] + ELL_SIZE, w->ct[l].val0, R_SIZE);
+            memcpy(w->mc0c1[l] + ELL_SIZE + R_SIZE, w->ct[l].val1, ELL_SIZE);
+        }
+        sha3_384_multi(hash_out, mc0c1_in, 2*ELL_SIZE + R_SIZE);
+
+        for (uint32_t l = 0; l < lanes; l++)
+        {
+            memcpy(ct[first + l], w->ct[l].raw, sizeof(ct_t));
+            memcpy(ss[first + l], w->hash[l], ELL_SIZE);
+        }
     }
 
     EXIT:
+    free(w);
 
-    DMSG("  Exit crypto_kem_dec.\n");
+    DMSG("  Exit crypto_kem_enc_batch.\n");
     return res;
 }
 
+// Fixed entropy of the warm-up calls of bike_init: the NIST DRBG is left
+// untouched, so the KAT outputs do not depend on whether it ran.
+#define INIT_SEED_BYTE 0xa5
+
+static status_t g_init_res = SUCCESS;
+static pthread_once_t g_init_once = PTHREAD_ONCE_INIT;
+
+// The process-wide part of bike_init.
+static void init_once(void)
+{
+    bike_dispatch();
+
+    if (sha3_384_init() != SUCCESS)
+    {
+        g_init_res = E_SHA384_FAIL;
+        return;
+    }
+
+    // A key schedule on a throwaway context loads the AES-256-ECB of the
+    // DRBG (FromNIST/rng.c), which the first randombytes would do otherwise.
+    const uint8_t key[32] = {0};
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    if ((ctx == NULL) ||
+        (EVP_EncryptInit_ex(ctx, EVP_aes_256_ecb(), NULL, key, NULL) != 1))
+    {
+        g_init_res = E_AES_SET_KEY_FAIL;
+    }
+    EVP_CIPHER_CTX_free(ctx);
+
+#ifndef BIKE_LOW_MEM
+    ntl_init();
+#endif
+}
+
+int bike_init(void)
+{
+    status_t res = SUCCESS;
+    double_seed_t seeds;
+    pk_t pk;
+    sk_t sk;
+    ct_t ct;
+    ss_t ss_enc;
+    ss_t ss_dec;
+    bike_ws_t* ws = NULL;
+#ifndef BIKE_LOW_MEM
+    flip_queue_t* fq = NULL;
+#endif
+
+    DMSG("  Enter bike_init.\n");
+
+    pthread_once(&g_init_once, init_once);
+    res = g_init_res; CHECK_STATUS(res);
+
+    // the calling thread's workspace, with every page faulted in
+    ws = bike_ws_thread();
+    if (ws == NULL)
+    {
+        ERR(E_ALLOCATION_FAILURE);
+    }
+#ifndef BIKE_LOW_MEM
+    // keep the flip queue of an earlier Backflip decode
+    fq = ws->fq;
+    memset(ws, 0, sizeof(bike_ws_t));
+    ws->fq = fq;
+#else
+    memset(ws, 0, sizeof(bike_ws_t));
+#endif
+
+    // One keygen, encaps and decaps on fixed seeds fault in the code and
+    // stack pages and set up the lazy state of the kernels (e.g. the NTT
+    // context of UPC_ENGINE_NTT); the decapsulation must agree.
+    memset(&seeds, INIT_SEED_BYTE, sizeof(seeds));
+    res = (status_t)crypto_kem_keypair_seeds(pk.raw, (unsigned char*)&sk, &seeds); CHECK_STATUS(res);
+    res = (status_t)crypto_kem_enc_seeds(ct.raw, ss_enc.raw, pk.raw, &seeds); CHECK_STATUS(res);
+    res = (status_t)crypto_kem_dec_ws(ss_dec.raw, ct.raw, (unsigned char*)&sk, ws); CHECK_STATUS(res);
+    if (memcmp(ss_enc.raw, ss_dec.raw, sizeof(ss_t)) != 0)
+    {
+        ERR(E_DECODING_FAILURE);
+    }
+
+#ifdef BIKE_STAGE_TIMING
+    // the warm-up is not part of the caller's profile
+    bike_stage_reset();
+#endif
+
+    EXIT:
+    DMSG("  Exit bike_init.\n");
+    return res;
+}
@@ -43,6 +43,8 @@
 #include "string.h"
 #include "utilities.h"
 #include "FromNIST/rng.h"
+#include "workspace.h"
+#include "decode_parallel.h"
 
 enum _seeds_purpose
 {
@@ -89,6 +91,73 @@ int crypto_kem_dec(OUT unsigned char *ss,
         IN const unsigned char *ct,
         IN const unsigned char *sk);
 
+//Keygenerate and encapsulate from caller-provided entropy seeds instead
+//              of get_seeds, e.g. from a per-thread DRBG (kem_async.h).
+int crypto_kem_keypair_seeds(OUT unsigned char *pk,
+        OUT unsigned char *sk,
+        IN const double_seed_t* seeds);
+
+int crypto_kem_enc_seeds(OUT unsigned char *ct,
+        OUT unsigned char *ss,
+        IN const unsigned char *pk,
+        IN const double_seed_t* seeds);
+
+//One-time setup - binds the kernels (dispatch.h), resolves the OpenSSL
+//              SHA3-384 and AES-256 implementations, builds the NTL
+//              modulus, faults in every page of the calling thread's
+//              workspace and runs one keygen, encaps and decaps on fixed
+//              seeds, so that none of it lands on the first real call.
+//              The NIST DRBG is not used. Call it once per thread that
+//              will run the KEM (the process-wide part runs once);
+//              without it the same setup happens lazily.
+int bike_init(void);
+
+//Decapsulate with every temporary in the workspace ws (workspace.h)
+//              instead of the stack; crypto_kem_dec runs this on the
+//              calling thread's workspace.
+int crypto_kem_dec_ws(OUT unsigned char *ss,
+        IN const unsigned char *ct,
+        IN const unsigned char *sk,
+        IN OUT bike_ws_t *ws);
+
+//Batched encapsulate - pk[i] are n public keys, ct[i] and ss[i] receive
+//              the output of encapsulating to pk[i]. Encapsulations are
+//              processed KECCAK_LANES at a time with multi-buffer Keccak;
+//              the output equals n sequential crypto_kem_enc calls.
+int crypto_kem_enc_batch(OUT unsigned char *ct[],
+        OUT unsigned char *ss[],
+        IN const unsigned char *const pk[],
+        IN const uint32_t n);
+
+#ifndef BIKE_LOW_MEM
+//Decapsulate on the workers of pool (decode_parallel.h): the BGF decoder
+//              runs on pool, with the calling thread as worker 0. The
+//              output equals crypto_kem_dec. DECODER_BACKFLIP decodes on
+//              the calling thread alone.
+int crypto_kem_dec_parallel(OUT unsigned char *ss,
+        IN const unsigned char *ct,
+        IN const unsigned char *sk,
+        IN bike_decode_pool_t *pool);
+
+//Decapsulate with the Backflip decoder (decode_backflip.c) whatever
+//              DECODER selects, e.g. to compare the two decoders in one
+//              build.
+int crypto_kem_dec_backflip(OUT unsigned char *ss,
+        IN const unsigned char *ct,
+        IN const unsigned char *sk);
+
+//Batched decapsulate - ct[i] are n key encapsulation messages under the
+//              same private key sk, ss[i] receives the shared secret of ct[i].
+//              The key is expanded once and every ciphertext decoded on
+//              the thread workspace with the kernels of crypto_kem_dec,
+//              whose output it equals. The decoders run one ciphertext at
+//              a time: no counter work is shared across the batch, only
+//              the key expansion and the workspace.
+int crypto_kem_dec_batch(OUT unsigned char *ss[],
+        IN const unsigned char *const ct[],
+        IN const unsigned char *sk,
+        IN const uint32_t n);
+#endif
 
 #endif //__KEM_H_INCLUDED__
 
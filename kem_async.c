@@ -0,0 +1,434 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "kem_async.h"
+#include "kem.h"
+#include "workspace.h"
+#include "FromNIST/rng.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+typedef struct async_queue_s
+{
+    bike_job_t* head;
+    bike_job_t* tail;
+} async_queue_t;
+
+typedef struct async_worker_s
+{
+    bike_kem_pool_t* pool WS_ALIGNED;
+    uint32_t id;
+    // the queues of the worker, also taken from by the others
+    pthread_mutex_t lock;
+    async_queue_t queue[BIKE_PRIO_COUNT];
+    // seeds of its keygen and encaps jobs
+    AES256_CTR_DRBG_struct drbg;
+    pthread_t thread;
+} async_worker_t;
+
+struct bike_kem_pool_s
+{
+    // jobs queued per class, counted before they are pushed and after
+    // they are taken, so a count is never below the queued jobs
+    uint32_t queued[BIKE_PRIO_COUNT] WS_ALIGNED;
+    // next worker to submit to
+    uint32_t next;
+    uint32_t stop;
+
+    // wake: a job was queued or the pool is stopping;
+    // done: a job completed (bike_job_wait)
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+
+    uint32_t n;
+    async_worker_t* workers;
+};
+
+_INLINE_ uint32_t async_pending(IN bike_kem_pool_t* pool)
+{
+    uint32_t pending = 0;
+    for (uint32_t p = 0; p < BIKE_PRIO_COUNT; p++)
+    {
+        pending += __atomic_load_n(&pool->queued[p], __ATOMIC_ACQUIRE);
+    }
+    return pending;
+}
+
+// The oldest job of the highest class: from the queue of worker self
+// first, then from the others in turn. NULL if there is none.
+static bike_job_t* async_take(IN OUT bike_kem_pool_t* pool, IN const uint32_t self)
+{
+    for (uint32_t p = 0; p < BIKE_PRIO_COUNT; p++)
+    {
+        if (__atomic_load_n(&pool->queued[p], __ATOMIC_ACQUIRE) == 0)
+        {
+            continue;
+        }
+
+        for (uint32_t k = 0; k < pool->n; k++)
+        {
+            async_worker_t* victim = &pool->workers[(self + k) % pool->n];
+            async_queue_t* q = &victim->queue[p];
+
+            pthread_mutex_lock(&victim->lock);
+            bike_job_t* job = q->head;
+            if (job != NULL)
+            {
+                q->head = job->next;
+                if (q->head == NULL)
+                {
+                    q->tail = NULL;
+                }
+            }
+            pthread_mutex_unlock(&victim->lock);
+
+            if (job != NULL)
+            {
+                __atomic_sub_fetch(&pool->queued[p], 1, __ATOMIC_ACQ_REL);
+                return job;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+_INLINE_ void async_seeds(OUT double_seed_t* seeds,
+        IN OUT async_worker_t* w,
+        IN const seeds_purpose_t purpose)
+{
+#ifdef NIST_RAND
+    (void)purpose;
+    randombytes_ctx(&w->drbg, seeds->raw, sizeof(double_seed_t));
+#else
+    (void)w;
+    get_seeds(seeds, purpose);
+#endif
+}
+
+static void async_run(IN OUT async_worker_t* w, IN OUT bike_job_t* job)
+{
+    bike_kem_pool_t* pool = w->pool;
+    const bike_job_done_t done = job->done;
+    void* arg = job->arg;
+    double_seed_t seeds = {0};
+    int res;
+
+    switch (job->op)
+    {
+    case BIKE_JOB_KEYPAIR:
+        async_seeds(&seeds, w, KEYGEN_SEEDS);
+        res = crypto_kem_keypair_seeds(job->out0, job->out1, &seeds);
+        break;
+    case BIKE_JOB_ENC:
+        async_seeds(&seeds, w, ENCAPS_SEEDS);
+        res = crypto_kem_enc_seeds(job->out0, job->out1, job->in0, &seeds);
+        break;
+    default:
+        res = crypto_kem_dec(job->out0, job->in0, job->in1);
+        break;
+    }
+
+    // from here on the owner may reuse or free the job
+    __atomic_store_n(&job->res, res, __ATOMIC_RELEASE);
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(&pool->done);
+    pthread_mutex_unlock(&pool->lock);
+
+    if (done != NULL)
+    {
+        done(res, arg);
+    }
+}
+
+static void* async_thread(IN void* arg)
+{
+    async_worker_t* w = (async_worker_t*)arg;
+    bike_kem_pool_t* pool = w->pool;
+
+    // the workspace, NTL scratch and stack of this worker, before its
+    // first job; a failure shows again in the jobs
+    bike_init();
+
+    for (;;)
+    {
+        bike_job_t* job = async_take(pool, w->id);
+        if (job != NULL)
+        {
+            async_run(w, job);
+            continue;
+        }
+
+        // a job counted but not pushed yet is picked up on the next pass
+        pthread_mutex_lock(&pool->lock);
+        while ((async_pending(pool) == 0) && !__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE))
+        {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        const int stop = (async_pending(pool) == 0);
+        pthread_mutex_unlock(&pool->lock);
+
+        if (stop)
+        {
+            return NULL;
+        }
+    }
+}
+
+_INLINE_ void async_pin(IN pthread_t thread, IN const uint32_t k)
+{
+#ifdef __linux__
+    const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu > 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(k % (uint32_t)ncpu, &set);
+        // best effort: an unpinned worker is only slower
+        pthread_setaffinity_np(thread, sizeof(set), &set);
+    }
+#else
+    (void)thread;
+    (void)k;
+#endif
+}
+
+bike_kem_pool_t* bike_kem_pool_create(IN const uint32_t n_threads)
+{
+    if (n_threads == 0)
+    {
+        return NULL;
+    }
+
+    void* mem = NULL;
+    if (posix_memalign(&mem, BIKE_WS_ALIGN, sizeof(bike_kem_pool_t)) != 0)
+    {
+        return NULL;
+    }
+    bike_kem_pool_t* pool = (bike_kem_pool_t*)mem;
+    memset(pool, 0, sizeof(bike_kem_pool_t));
+
+    if (posix_memalign(&mem, BIKE_WS_ALIGN, n_threads * sizeof(async_worker_t)) != 0)
+    {
+        free(pool);
+        return NULL;
+    }
+    pool->workers = (async_worker_t*)mem;
+    memset(pool->workers, 0, n_threads * sizeof(async_worker_t));
+
+    pool->n = n_threads;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (uint32_t w = 0; w < n_threads; w++)
+    {
+        async_worker_t* worker = &pool->workers[w];
+        unsigned char entropy[48];
+
+        worker->pool = pool;
+        worker->id = w;
+        pthread_mutex_init(&worker->lock, NULL);
+        randombytes(entropy, sizeof(entropy));
+        randombytes_init_ctx(&worker->drbg, entropy, NULL, 256);
+    }
+
+    for (uint32_t w = 0; w < n_threads; w++)
+    {
+        if (pthread_create(&pool->workers[w].thread, NULL, async_thread, &pool->workers[w]) != 0)
+        {
+            // join the ones already running
+            pool->n = w;
+            bike_kem_pool_destroy(pool);
+            return NULL;
+        }
+        async_pin(pool->workers[w].thread, w);
+    }
+
+    return pool;
+}
+
+void bike_kem_pool_destroy(IN bike_kem_pool_t* pool)
+{
+    if (pool == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    __atomic_store_n(&pool->stop, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (uint32_t w = 0; w < pool->n; w++)
+    {
+        pthread_join(pool->workers[w].thread, NULL);
+        pthread_mutex_destroy(&pool->workers[w].lock);
+    }
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+static int async_submit(IN OUT bike_kem_pool_t* pool, IN OUT bike_job_t* job)
+{
+    // stop is checked and the job queued under pool->lock: a worker leaves
+    // only when it sees stop and no job counted under the same lock, so a
+    // job accepted here always runs before bike_kem_pool_destroy joins
+    pthread_mutex_lock(&pool->lock);
+    if (__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE))
+    {
+        pthread_mutex_unlock(&pool->lock);
+        job->res = E_POOL_STOPPED;
+        return E_POOL_STOPPED;
+    }
+
+    job->next = NULL;
+    __atomic_store_n(&job->res, BIKE_JOB_PENDING, __ATOMIC_RELAXED);
+
+    // the workers in turn; the idle ones steal from the busy ones
+    const uint32_t w = __atomic_fetch_add(&pool->next, 1, __ATOMIC_RELAXED) % pool->n;
+    async_worker_t* worker = &pool->workers[w];
+    async_queue_t* q = &worker->queue[job->prio];
+
+    __atomic_add_fetch(&pool->queued[job->prio], 1, __ATOMIC_ACQ_REL);
+    pthread_mutex_lock(&worker->lock);
+    if (q->tail == NULL)
+    {
+        q->head = job;
+    }
+    else
+    {
+        q->tail->next = job;
+    }
+    q->tail = job;
+    pthread_mutex_unlock(&worker->lock);
+
+    pthread_cond_signal(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    return SUCCESS;
+}
+
+_INLINE_ void async_job(OUT bike_job_t* job,
+        IN const bike_job_op_t op,
+        IN const bike_job_prio_t prio,
+        OUT unsigned char* out0,
+        OUT unsigned char* out1,
+        IN const unsigned char* in0,
+        IN const unsigned char* in1,
+        IN bike_job_done_t done,
+        IN void* arg)
+{
+    job->op = op;
+    job->prio = (prio < BIKE_PRIO_COUNT) ? prio : BIKE_PRIO_LOW;
+    job->out0 = out0;
+    job->out1 = out1;
+    job->in0 = in0;
+    job->in1 = in1;
+    job->done = done;
+    job->arg = arg;
+}
+
+int bike_kem_submit_keypair(IN bike_kem_pool_t* pool,
+        OUT bike_job_t* job,
+        IN const bike_job_prio_t prio,
+        OUT unsigned char* pk,
+        OUT unsigned char* sk,
+        IN bike_job_done_t done,
+        IN void* arg)
+{
+    async_job(job, BIKE_JOB_KEYPAIR, prio, pk, sk, NULL, NULL, done, arg);
+    return async_submit(pool, job);
+}
+
+int bike_kem_submit_enc(IN bike_kem_pool_t* pool,
+        OUT bike_job_t* job,
+        IN const bike_job_prio_t prio,
+        OUT unsigned char* ct,
+        OUT unsigned char* ss,
+        IN const unsigned char* pk,
+        IN bike_job_done_t done,
+        IN void* arg)
+{
+    async_job(job, BIKE_JOB_ENC, prio, ct, ss, pk, NULL, done, arg);
+    return async_submit(pool, job);
+}
+
+int bike_kem_submit_dec(IN bike_kem_pool_t* pool,
+        OUT bike_job_t* job,
+        IN const bike_job_prio_t prio,
+        OUT unsigned char* ss,
+        IN const unsigned char* ct,
+        IN const unsigned char* sk,
+        IN bike_job_done_t done,
+        IN void* arg)
+{
+    async_job(job, BIKE_JOB_DEC, prio, ss, NULL, ct, sk, done, arg);
+    return async_submit(pool, job);
+}
+
+int bike_job_poll(IN const bike_job_t* job)
+{
+    return __atomic_load_n(&job->res, __ATOMIC_ACQUIRE);
+}
+
+int bike_job_wait(IN bike_kem_pool_t* pool, IN const bike_job_t* job)
+{
+    int res = bike_job_poll(job);
+    if (res != BIKE_JOB_PENDING)
+    {
+        return res;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    while ((res = bike_job_poll(job)) == BIKE_JOB_PENDING)
+    {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return res;
+}
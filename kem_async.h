@@ -0,0 +1,146 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _KEM_ASYNC_H_
+#define _KEM_ASYNC_H_
+
+#include "types.h"
+
+// Asynchronous KEM jobs. A pool of worker threads, pinned to CPUs, runs
+// keygen, encaps and decaps jobs submitted from any thread without
+// blocking it; the submitter learns of the completion from a callback (run
+// on the worker) or by polling the job.
+//
+// Every worker has a queue per priority class; submissions go to the
+// workers in turn. A worker takes the oldest job of the highest class
+// present in the pool, from its own queue first and otherwise stolen from
+// another worker's, so a decaps of class BIKE_PRIO_HIGH waits for at most
+// the jobs already running. Every worker owns its DRBG (seeded from
+// randombytes when the pool is created), its workspace and its NTL
+// scratch, set up by bike_init when it starts. The blocking crypto_kem_*
+// calls do not use the pool.
+
+typedef enum
+{
+    BIKE_PRIO_HIGH   = 0, // e.g. the decaps of a handshake in progress
+    BIKE_PRIO_NORMAL = 1,
+    BIKE_PRIO_LOW    = 2, // e.g. keygen ahead of time
+    BIKE_PRIO_COUNT
+} bike_job_prio_t;
+
+typedef enum
+{
+    BIKE_JOB_KEYPAIR = 0,
+    BIKE_JOB_ENC     = 1,
+    BIKE_JOB_DEC     = 2
+} bike_job_op_t;
+
+// Result of a job that has not completed yet.
+#define BIKE_JOB_PENDING (-1)
+
+// Called on the worker when a job completes, with its result (0 or a
+// status_t). It may submit new jobs.
+typedef void (*bike_job_done_t)(IN int res, IN void* arg);
+
+// A job lives in caller memory from its submission until it completes.
+// The fields are set by the submit functions and owned by the pool.
+typedef struct bike_job_s
+{
+    bike_job_op_t op;
+    bike_job_prio_t prio;
+    unsigned char* out0;
+    unsigned char* out1;
+    const unsigned char* in0;
+    const unsigned char* in1;
+    bike_job_done_t done;
+    void* arg;
+    struct bike_job_s* next;
+    int res;
+} bike_job_t;
+
+typedef struct bike_kem_pool_s bike_kem_pool_t;
+
+// Pool of n_threads workers, worker k pinned to CPU k mod the number of
+// online CPUs (Linux). Draws the seeds of the worker DRBGs from
+// randombytes. Returns NULL if n_threads is 0 or the threads cannot be
+// created.
+bike_kem_pool_t* bike_kem_pool_create(IN const uint32_t n_threads);
+
+// Runs the jobs still queued, then stops and joins the workers, and frees
+// the pool; a NULL pool is ignored. Submitting from any other thread once
+// destroy has been called is an error (the pool may already be freed):
+// only the done callbacks of the jobs still running may submit, and they
+// get E_POOL_STOPPED.
+void bike_kem_pool_destroy(IN bike_kem_pool_t* pool);
+
+// Queue a crypto_kem_keypair, crypto_kem_enc or crypto_kem_dec on the
+// pool; done (may be NULL) gets arg. The buffers must stay valid until the
+// job completes. Returns SUCCESS, or E_POOL_STOPPED from a done callback
+// while the pool is being destroyed.
+int bike_kem_submit_keypair(IN bike_kem_pool_t* pool,
+        OUT bike_job_t* job,
+        IN const bike_job_prio_t prio,
+        OUT unsigned char* pk,
+        OUT unsigned char* sk,
+        IN bike_job_done_t done,
+        IN void* arg);
+
+int bike_kem_submit_enc(IN bike_kem_pool_t* pool,
+        OUT bike_job_t* job,
+        IN const bike_job_prio_t prio,
+        OUT unsigned char* ct,
+        OUT unsigned char* ss,
+        IN const unsigned char* pk,
+        IN bike_job_done_t done,
+        IN void* arg);
+
+int bike_kem_submit_dec(IN bike_kem_pool_t* pool,
+        OUT bike_job_t* job,
+        IN const bike_job_prio_t prio,
+        OUT unsigned char* ss,
+        IN const unsigned char* ct,
+        IN const unsigned char* sk,
+        IN bike_job_done_t done,
+        IN void* arg);
+
+// The result of the job, or BIKE_JOB_PENDING. Does not block.
+int bike_job_poll(IN const bike_job_t* job);
+
+// Blocks until the job completes and returns its result.
+int bike_job_wait(IN bike_kem_pool_t* pool, IN const bike_job_t* job);
+
+#endif //_KEM_ASYNC_H_
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "kem_stages.h"
+
+#ifdef BIKE_STAGE_TIMING
+
+#include <string.h>
+
+static __thread bike_stage_stats_t g_stages;
+
+static const char* const g_stage_names[BIKE_STAGE_COUNT] = {
+    "keygen: sample h0, h1",
+    "keygen: inverse",
+    "keygen: multiply",
+    "encaps: H",
+    "encaps: multiply",
+    "encaps: L",
+    "encaps: K",
+    "decaps: syndrome",
+    "decaps: decode",
+    "decaps: L",
+    "decaps: H",
+    "decaps: K",
+};
+
+void bike_stage_snapshot(OUT bike_stage_stats_t* stats)
+{
+    *stats = g_stages;
+}
+
+void bike_stage_reset(void)
+{
+    memset(&g_stages, 0, sizeof(g_stages));
+}
+
+const char* bike_stage_name(IN const bike_stage_t stage)
+{
+    return (stage < BIKE_STAGE_COUNT) ? g_stage_names[stage] : "";
+}
+
+void bike_stage_add(IN const bike_stage_t stage, IN const uint64_t ticks)
+{
+    g_stages.ticks[stage] += ticks;
+    g_stages.calls[stage]++;
+}
+
+#endif //BIKE_STAGE_TIMING
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _KEM_STAGES_H_
+#define _KEM_STAGES_H_
+
+#include "types.h"
+#include "utilities.h"
+
+// Stages of the KEM timed under BIKE_STAGE_TIMING (defs.h).
+typedef enum
+{
+    BIKE_STAGE_KEYGEN_SAMPLE = 0, // h0, h1
+    BIKE_STAGE_KEYGEN_INV,        // h0^-1
+    BIKE_STAGE_KEYGEN_MUL,        // h1 * h0^-1
+    BIKE_STAGE_ENC_H,             // e = H(m)
+    BIKE_STAGE_ENC_MUL,           // c0 = e0 + e1*h
+    BIKE_STAGE_ENC_L,             // c1 = L(e) ^ m
+    BIKE_STAGE_ENC_K,             // K(m || c0 || c1)
+    BIKE_STAGE_DEC_SYNDROME,      // s = c0*h0
+    BIKE_STAGE_DEC_DECODE,        // e' from s
+    BIKE_STAGE_DEC_L,             // m' = c1 ^ L(e')
+    BIKE_STAGE_DEC_H,             // H(m') and its comparison with e'
+    BIKE_STAGE_DEC_K,             // the shared secret
+    BIKE_STAGE_COUNT
+} bike_stage_t;
+
+// Ticks (bike_ticks units) and calls per stage.
+typedef struct bike_stage_stats_s
+{
+    uint64_t ticks[BIKE_STAGE_COUNT];
+    uint64_t calls[BIKE_STAGE_COUNT];
+} bike_stage_stats_t;
+
+#ifdef BIKE_STAGE_TIMING
+
+// The accumulators of the calling thread: copy, clear, and a stage name.
+void bike_stage_snapshot(OUT bike_stage_stats_t* stats);
+void bike_stage_reset(void);
+const char* bike_stage_name(IN const bike_stage_t stage);
+
+void bike_stage_add(IN const bike_stage_t stage, IN const uint64_t ticks);
+
+// Runs the statements and adds their time to the stage.
+#define BIKE_STAGE(stage, ...) \
+    { \
+        const uint64_t stage_t0_ = bike_ticks(); \
+        __VA_ARGS__ \
+        bike_stage_add(stage, bike_ticks() - stage_t0_); \
+    }
+
+#else
+
+#define BIKE_STAGE(stage, ...) { __VA_ARGS__ }
+
+#endif //BIKE_STAGE_TIMING
+
+#endif //_KEM_STAGES_H_
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _BIKE_KEM_H_
+#define _BIKE_KEM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// All three security levels in one binary. Every level is compiled
+// separately from the same sources (bike_level.inc), so its sizes and loop
+// bounds are compile-time constants, and its symbols live in the namespace
+// bike_l1, bike_l3 or bike_l5. bike_kem(level) returns the entry points.
+
+typedef struct bike_kem_s
+{
+    uint32_t level;     // NIST security level: 1, 3 or 5
+    uint32_t r_bits;
+    size_t pk_bytes;
+    size_t sk_bytes;
+    size_t ct_bytes;
+    size_t ss_bytes;
+
+    int (*keypair)(unsigned char *pk, unsigned char *sk);
+    int (*enc)(unsigned char *ct, unsigned char *ss, const unsigned char *pk);
+    int (*dec)(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+    int (*init)(void);  // bike_init of kem.h
+    // crypto_kem_dec_backflip of kem.h: decaps with the Backflip decoder
+    // (NULL in BIKE_LOW_MEM builds)
+    int (*dec_backflip)(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+} bike_kem_t;
+
+extern const bike_kem_t bike_kem_level1;
+extern const bike_kem_t bike_kem_level3;
+extern const bike_kem_t bike_kem_level5;
+
+// The KEM of a NIST security level (1, 3 or 5); NULL for other levels.
+const bike_kem_t* bike_kem(uint32_t level);
+
+#endif //_BIKE_KEM_H_
@@ -39,14 +39,20 @@
 #ifndef MEASURE_H
 #define MEASURE_H
 
+#ifndef _GNU_SOURCE
 #define _GNU_SOURCE
+#endif
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
+#include <sys/ioctl.h>
 #include <sys/types.h>
 #include <sys/syscall.h>
 #include <linux/perf_event.h>
+#include "types.h"
 
 #ifndef REPEAT
 #define REPEAT 10
@@ -56,47 +62,246 @@
 #define OUTER_REPEAT 1
 #endif
 
-#ifndef RDTSC
-//Less accurate measurement than with RDTSC
-#include <time.h>
-#include <chrono>
+#ifndef WARMUP
+#define WARMUP REPEAT/4
+#endif
 
+/*
+   MEASURE(msg, x) runs "x" WARMUP times, then OUTER_REPEAT times REPEAT
+   times, and prints the best per-iteration average. Two backends:
 
-std::chrono::steady_clock::time_point start;
-std::chrono::steady_clock::time_point end;
+   - perf (default): a perf_event_open group of cycles, instructions, L1D
+     read misses and branch misses, counted in user space around the block,
+     and the time from clock_gettime. An event the PMU does not offer is
+     left out; without perf at all (perf_event_paranoid > 2, containers,
+     no PMU) or with BIKE_PERF=off only the time is printed.
+   - RDTSC on x86-64 (defs.h): the TSC around the block.
+ */
 
+////////////////////////////////////////////////////////////////
+//                 perf_event_open counter group
+////////////////////////////////////////////////////////////////
 
-#define MEASURE(msg, x) start = std::chrono::steady_clock::now();\
-		for (int i = 0; i < REPEAT; i++)   \
-        {                                                                                             \
-                {x};                                                                                       \
-        }\
-        end = std::chrono::steady_clock::now(); \
-        printf(msg); \
-        printf("\ttook %lfs (%d repetitions)\n", ((double) std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()/CLOCKS_PER_SEC), REPEAT);
-#endif
+typedef enum
+{
+    PERF_EV_CYCLES = 0,
+    PERF_EV_INSTRUCTIONS,
+    PERF_EV_L1D_MISSES,
+    PERF_EV_BRANCH_MISSES,
+    PERF_EV_COUNT
+} perf_ev_t;
 
+typedef struct perf_group_s
+{
+    int      leader;               // fd of the leader, -1: time only
+    int      fd[PERF_EV_COUNT];    // -1 when the event is not available
+    uint32_t slot[PERF_EV_COUNT];  // position in the group read
+    uint32_t n;                    // open events
+    struct timespec t0;
+} perf_group_t;
 
-/* This part defines the functions and MACROS needed to measure using RDTSC */
-#ifdef RDTSC
+// The counts of one measured block (scaled if the PMU was multiplexed).
+typedef struct perf_sample_s
+{
+    double   ns;
+    double   ev[PERF_EV_COUNT];
+    uint32_t valid;                // bit (1 << perf_ev_t) per counted event
+} perf_sample_t;
 
-#ifndef WARMUP
-#define WARMUP REPEAT/4
+static const char* const perf_ev_names[PERF_EV_COUNT] = {
+    "cycles", "instructions", "L1D misses", "branch misses"
+};
+
+_INLINE_ int perf_ev_open(const uint32_t type, const uint64_t config, const int group)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.disabled       = (group == -1);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                          PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+// Opens the counters of the calling thread; g->leader is -1 if none is.
+_INLINE_ void perf_group_open(perf_group_t* g)
+{
+    static const uint32_t type[PERF_EV_COUNT] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+    };
+    static const uint64_t config[PERF_EV_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    memset(g, 0, sizeof(*g));
+    g->leader = -1;
+
+    const char* env = getenv("BIKE_PERF");
+    const int off = (env != NULL) && (strcmp(env, "off") == 0 || strcmp(env, "0") == 0);
+
+    for (uint32_t i = 0; i < PERF_EV_COUNT; i++)
+    {
+        g->fd[i] = off ? -1 : perf_ev_open(type[i], config[i], g->leader);
+        if (g->fd[i] < 0)
+        {
+            g->fd[i] = -1;
+            continue;
+        }
+        if (g->leader == -1)
+        {
+            g->leader = g->fd[i];
+        }
+        g->slot[i] = g->n++;
+    }
+}
+
+_INLINE_ void perf_group_close(perf_group_t* g)
+{
+    for (uint32_t i = 0; i < PERF_EV_COUNT; i++)
+    {
+        if (g->fd[i] != -1)
+        {
+            close(g->fd[i]);
+            g->fd[i] = -1;
+        }
+    }
+    g->leader = -1;
+    g->n      = 0;
+}
+
+_INLINE_ void perf_group_start(perf_group_t* g)
+{
+    if (g->leader != -1)
+    {
+        ioctl(g->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(g->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &g->t0);
+}
+
+_INLINE_ void perf_group_stop(perf_group_t* g, perf_sample_t* s)
+{
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    memset(s, 0, sizeof(*s));
+    s->ns = (double)(t1.tv_sec - g->t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - g->t0.tv_nsec);
+
+    if (g->leader == -1)
+    {
+        return;
+    }
+    ioctl(g->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // nr, time enabled, time running, one value per event
+    uint64_t buf[3 + PERF_EV_COUNT];
+    const ssize_t len = read(g->leader, buf, sizeof(buf));
+    if ((len < (ssize_t)(3 * sizeof(uint64_t))) || (buf[0] != g->n) || (buf[2] == 0))
+    {
+        return;
+    }
+    const double scale = (double)buf[1] / (double)buf[2];
+
+    for (uint32_t i = 0; i < PERF_EV_COUNT; i++)
+    {
+        if (g->fd[i] != -1)
+        {
+            s->ev[i]   = (double)buf[3 + g->slot[i]] * scale;
+            s->valid  |= 1U << i;
+        }
+    }
+}
+
+// The group of MEASURE, opened on first use.
+_INLINE_ perf_group_t* perf_measure_group(void)
+{
+    static perf_group_t g;
+    static int opened = 0;
+    if (!opened)
+    {
+        perf_group_open(&g);
+        opened = 1;
+    }
+    return &g;
+}
+
+// Prints the sample divided by reps: the counted events and the time.
+_INLINE_ void perf_sample_print(const perf_sample_t* s, const uint32_t reps)
+{
+    for (uint32_t i = 0; i < PERF_EV_COUNT; i++)
+    {
+        if (s->valid & (1U << i))
+        {
+            printf(" %.0f %s,", s->ev[i] / reps, perf_ev_names[i]);
+        }
+    }
+    if ((s->valid & 3U) == 3U && s->ev[PERF_EV_CYCLES] > 0)
+    {
+        printf(" IPC %.2f,", s->ev[PERF_EV_INSTRUCTIONS] / s->ev[PERF_EV_CYCLES]);
+    }
+    printf(" %.2f us", s->ns / reps / 1000.0);
+}
+
+#if !defined(RDTSC) || !defined(__x86_64__)
+
+perf_sample_t PERF_best;
+perf_sample_t PERF_sample;
+int PERF_MEASURE_ITERATOR;
+int PERF_OUTER_ITERATOR;
+
+/*
+   Same flow as RDTSC_MEASURE, with the counter group around the REPEAT
+   loop; the best outer run is the one of fewest cycles, or of least time
+   without a cycle counter.
+ */
+#define PERF_MEASURE(msg, x)                                                                     \
+        for(PERF_MEASURE_ITERATOR=0; PERF_MEASURE_ITERATOR< WARMUP; PERF_MEASURE_ITERATOR++)       \
+        {                                                                                        \
+            {x};                                                                                 \
+        }                                                                                        \
+        for(PERF_OUTER_ITERATOR=0;PERF_OUTER_ITERATOR<OUTER_REPEAT; PERF_OUTER_ITERATOR++){     \
+            perf_group_start(perf_measure_group());                                              \
+            for (PERF_MEASURE_ITERATOR = 0; PERF_MEASURE_ITERATOR < REPEAT; PERF_MEASURE_ITERATOR++) \
+            {                                                                                    \
+                {x};                                                                             \
+            }                                                                                    \
+            perf_group_stop(perf_measure_group(), &PERF_sample);                                 \
+            if((PERF_OUTER_ITERATOR == 0) ||                                                     \
+               ((PERF_sample.valid & 1U) ? (PERF_sample.ev[PERF_EV_CYCLES] < PERF_best.ev[PERF_EV_CYCLES]) \
+                                         : (PERF_sample.ns < PERF_best.ns)))                     \
+                PERF_best = PERF_sample;                                                         \
+        } printf(msg); \
+        printf(" took"); perf_sample_print(&PERF_best, REPEAT); \
+        printf(" in average (%d repetitions)\n", REPEAT);
+
+#define MEASURE_BACKEND "perf_event_open counters"
+#define MEASURE(msg, x) PERF_MEASURE(msg, x)
 #endif
 
+
+/* This part defines the functions and MACROS needed to measure using RDTSC */
+#if defined(RDTSC) && defined(__x86_64__)
+
 unsigned long long RDTSC_start_clk, RDTSC_end_clk;
 double RDTSC_total_clk;
 double RDTSC_TEMP_CLK;
 int RDTSC_MEASURE_ITERATOR;
 int RDTSC_OUTER_ITERATOR;
 
-
-inline static uint32_t get_Clks(void)
+inline static uint64_t get_Clks(void)
 {
-    uint32_t pmccntr;
- 	
-	asm volatile("mrc p15, 0, %0, c9, c13, 0" : "=r"(pmccntr));
-	return (uint32_t)(pmccntr);
+    uint32_t lo, hi;
+    asm volatile("rdtscp\n\t" : "=a"(lo), "=d"(hi) :: "rcx");
+    return ((uint64_t)hi << 32) | lo;
 }
 
 /*
@@ -128,6 +333,7 @@ inline static uint32_t get_Clks(void)
 
 
 #ifndef COHO
+#define MEASURE_BACKEND "unconditioned RDTSC"
 #define MEASURE(msg, x) RDTSC_MEASURE(msg, x)
 #endif
 
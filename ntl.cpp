@@ -35,6 +35,9 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  ******************************************************************************/
 
+// The BIKE_LOW_MEM profile does not link NTL (see gf2x.h).
+#ifndef BIKE_LOW_MEM
+
 extern "C" {
 #include "types.h"
 }
@@ -45,34 +48,36 @@ using namespace NTL;
 
 typedef unsigned char uint8_t;
 
-void ntl_add(OUT uint8_t res_bin[R_SIZE],
-        IN const uint8_t a_bin[R_SIZE],
-        IN const uint8_t b_bin[R_SIZE])
+// The modulus x^R_BITS + 1 with its precomputed reduction data, built on
+// first use and then only read (concurrent reads of an NTL object are
+// thread-safe).
+static GF2X ntl_poly_modulus(void)
 {
-    GF2X a, b, res;
-
-    GF2XFromBytes(a, a_bin, R_SIZE);
-    GF2XFromBytes(b, b_bin, R_SIZE);
+    GF2X m;
+    SetCoeff(m, 0, 1);
+    SetCoeff(m, R_BITS, 1);
+    return m;
+}
 
-    add(res, a, b);
+static const GF2XModulus& ntl_modulus(void)
+{
+    static const GF2XModulus m(ntl_poly_modulus());
+    return m;
+}
 
-    BytesFromGF2X(res_bin, res, R_SIZE);
+void ntl_init(void)
+{
+    ntl_modulus();
 }
 
 void ntl_mod_inv(OUT uint8_t res_bin[R_SIZE],
         IN const uint8_t a_bin[R_SIZE])
 {
-    GF2X _m, a, res;
+    GF2X a, res;
 
     GF2XFromBytes(a, a_bin, R_SIZE);
 
-    //Create the modulus
-    GF2XModulus m;
-    SetCoeff(_m, 0, 1);
-    SetCoeff(_m, R_BITS, 1);
-    build(m, _m);
-
-    InvMod(res, a, m);
+    InvMod(res, a, ntl_modulus());
     BytesFromGF2X(res_bin, res, R_SIZE);
 }
 
@@ -80,32 +85,14 @@ void ntl_mod_mul(OUT uint8_t res_bin[R_SIZE],
         IN const uint8_t a_bin[R_SIZE],
         IN const uint8_t b_bin[R_SIZE])
 {
-    GF2X _m, a, b, res;
+    GF2X a, b, res;
 
     GF2XFromBytes(a, a_bin, R_SIZE);
     GF2XFromBytes(b, b_bin, R_SIZE);
 
-    //Create the modulus
-    GF2XModulus m;
-    SetCoeff(_m, 0, 1);
-    SetCoeff(_m, R_BITS, 1);
-    build(m, _m);
-
-    MulMod(res, a, b, m);
+    MulMod(res, a, b, ntl_modulus());
 
     BytesFromGF2X(res_bin, res, R_SIZE);
 }
 
-void ntl_split_polynomial(OUT uint8_t e0[R_SIZE],
-        OUT uint8_t e1[R_SIZE],
-        IN const uint8_t e[2*R_SIZE])
-{
-    GF2X e_pol, e0_pol, e1_pol;
-    GF2XFromBytes(e_pol, e, N_SIZE);
-    trunc(e0_pol, e_pol, R_BITS);
-    RightShift(e1_pol, e_pol, R_BITS);
-
-    BytesFromGF2X(e0, e0_pol, R_SIZE);
-    BytesFromGF2X(e1, e1_pol, R_SIZE);
-}
-
+#endif //BIKE_LOW_MEM
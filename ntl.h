@@ -40,9 +40,9 @@
 
 #include "types.h"
 
-void ntl_add(OUT uint8_t res_bin[R_SIZE],
-        IN const uint8_t a_bin[R_SIZE],
-        IN const uint8_t b_bin[R_SIZE]);
+// Builds the modulus x^R_BITS + 1 shared by the calls below (they do it on
+// first use).
+void ntl_init(void);
 
 void ntl_mod_inv(OUT uint8_t res_bin[R_SIZE],
         IN const uint8_t a_bin[R_SIZE]);
@@ -51,8 +51,4 @@ void ntl_mod_mul(OUT uint8_t res_bin[R_SIZE],
         IN const uint8_t a_bin[R_SIZE],
         IN const uint8_t b_bin[R_SIZE]);
 
-void ntl_split_polynomial(OUT uint8_t e0[R_SIZE],
-        OUT uint8_t e1[R_SIZE],
-        IN const uint8_t e[2*R_SIZE]);
-
 #endif
@@ -127,3 +127,63 @@ status_t generate_sparse_rep_keccak(OUT uint8_t * r,
     return res;
 }
 
+
+// Every draw of get_rand_mod_len_keccak consumes 4 bytes and
+// SHAKE256_BLOCK_SIZE is a multiple of 4, so all streams cross block
+// boundaries after the same number of draws: the lanes can be squeezed
+// in lock step until the last one reached the required weight.
+status_t generate_sparse_rep_keccak_multi(OUT uint8_t *const r[KECCAK_LANES],
+        IN const uint32_t weight,
+        IN const uint32_t len,
+        IN OUT keccak_multi_state_t *prf_state)
+{
+    const uint64_t mask = MASK(bit_scan_reverse(len));
+    status_t res = SUCCESS;
+
+    uint8_t block[KECCAK_LANES][SHAKE256_STATE_SIZE];
+    uint32_t ctr[KECCAK_LANES] = {0};
+    uint32_t done = 0;
+
+    //Ensure r is zero.
+    for (uint32_t l = 0; l < KECCAK_LANES; l++)
+    {
+        setZero(r[l], DIVIDE_AND_CEIL(len, 8ULL));
+    }
+
+    while (1)
+    {
+        keccak_multi_extract(block, prf_state, SHAKE256_BLOCK_SIZE);
+
+        for (uint32_t l = 0; l < KECCAK_LANES; l++)
+        {
+            for (uint32_t i = 0; (i < SHAKE256_BLOCK_SIZE) && (ctr[l] != weight); i += sizeof(uint32_t))
+            {
+                uint32_t rand_pos;
+                memcpy(&rand_pos, &block[l][i], sizeof(rand_pos));
+
+                //Mask only relevant bits
+                rand_pos &= mask;
+
+                if ((rand_pos < len) && !CHECK_BIT(r[l], rand_pos))
+                {
+                    //No collision set the bit
+                    SET_BIT(r[l], rand_pos);
+                    if (++ctr[l] == weight)
+                    {
+                        done++;
+                    }
+                }
+            }
+        }
+
+        if (done == KECCAK_LANES)
+        {
+            break;
+        }
+
+        //next block of all streams
+        KeccakF1600_multi(prf_state);
+    }
+
+    return res;
+}
@@ -41,6 +41,7 @@
 #include "FromNIST/rng.h"
 #include "openssl_utils.h"
 #include "shake_prng.h"
+#include "keccak_multi.h"
 
 typedef enum
 {
@@ -55,6 +56,14 @@ status_t generate_sparse_rep_keccak(OUT uint8_t* r,
         IN const uint32_t len,
         IN OUT shake256_prng_state_t *prf_state);
 
+//Generate KECCAK_LANES sparse vectors r[l] from the SHAKE256 streams of
+//the multi-buffer state; r[l] equals what generate_sparse_rep_keccak
+//returns for the l-th stream.
+status_t generate_sparse_rep_keccak_multi(OUT uint8_t *const r[KECCAK_LANES],
+        IN const uint32_t weight,
+        IN const uint32_t len,
+        IN OUT keccak_multi_state_t *prf_state);
+
 // sample a single number smaller than len.
 status_t get_rand_mod_len_keccak(OUT uint32_t* rand_pos,
         IN const uint32_t len,
@@ -36,22 +36,24 @@
  ******************************************************************************/
 
 #include "shake_prng.h"
+#include "dispatch.h"
 #include "string.h"
 #include "stdio.h"
 #include "utilities.h"
 
 // Initialize KECCAK
 void shake256_init(const u8 *in, u64 inLen, shake256_prng_state_t *s){
+    const keccak_permute_t permute = bike_dispatch()->keccak_f1600;
     ui r=1088; ui c=256; u8 sfx=0x1F;
     /*initialize*/ ui R=r/8; ui i,b=0; FOR(i,SHAKE256_STATE_SIZE) s->buffer[i]=0;
-    /*absorb*/ while(inLen>0) { b=(inLen<R)?inLen:R; FOR(i,b) s->buffer[i]^=in[i]; in+=b; inLen-=b; if (b==R) { KeccakF1600(s->buffer); b=0; } }
-    /*pad*/ s->buffer[b]^=sfx; if((sfx&0x80)&&(b==(R-1))) KeccakF1600(s->buffer); s->buffer[R-1]^=0x80; KeccakF1600(s->buffer);
+    /*absorb*/ while(inLen>0) { b=(inLen<R)?inLen:R; FOR(i,b) s->buffer[i]^=in[i]; in+=b; inLen-=b; if (b==R) { permute(s->buffer); b=0; } }
+    /*pad*/ s->buffer[b]^=sfx; if((sfx&0x80)&&(b==(R-1))) permute(s->buffer); s->buffer[R-1]^=0x80; permute(s->buffer);
     s->pos = 0;
 }
 
 // Squeeze
 void shake256_squeeze(shake256_prng_state_t *s){
-    KeccakF1600(s->buffer);
+    bike_dispatch()->keccak_f1600(s->buffer);
 }
 
 // generate random number
@@ -36,6 +36,35 @@
 #include "kem.h"
 #include "utilities.h"
 #include "measurements.h"
+#include "kem_stages.h"
+
+#ifdef BIKE_STAGE_TIMING
+// Calls, ticks per call and share of the total of every stage.
+static void print_stages(void)
+{
+    bike_stage_stats_t st;
+    bike_stage_snapshot(&st);
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < BIKE_STAGE_COUNT; i++)
+    {
+        total += st.ticks[i];
+    }
+
+    MSG("\nStages (bike_ticks):\n");
+    for (uint32_t i = 0; i < BIKE_STAGE_COUNT; i++)
+    {
+        if (st.calls[i] == 0)
+        {
+            continue;
+        }
+        MSG("  %-22s calls %6llu  ticks/call %12.0f  %5.1f%%\n",
+            bike_stage_name((bike_stage_t)i), (unsigned long long)st.calls[i],
+            (double)st.ticks[i] / st.calls[i],
+            total ? 100.0 * st.ticks[i] / total : 0.0);
+    }
+}
+#endif
 
 
 ////////////////////////////////////////////////////////////////
@@ -49,9 +78,7 @@ int main(int argc, char **argv)
     ss_t k_enc = {0}; // shared secret after encapsulate
     ss_t k_dec = {0}; // shared secret after decapsulate
 
-    MSG("BIKE Demo Test - unconditioned RDTSC:\n");
-   
-    //init_perfcounters(1, 0);
+    MSG("BIKE Demo Test - " MEASURE_BACKEND ":\n");
 
     for (uint32_t i=1; i <= NUM_OF_CODE_TESTS; ++i)
     {
@@ -105,5 +132,9 @@ int main(int argc, char **argv)
         }
     }
 
+#ifdef BIKE_STAGE_TIMING
+    print_stages();
+#endif
+
     return 0;
 }
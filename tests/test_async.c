@@ -0,0 +1,275 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include "kem.h"
+#include "kem_async.h"
+
+// Runs keygen, encaps and decaps jobs on pools of 1, 2, 4 and all online
+// CPUs (or the thread counts given on the command line), with callbacks
+// and with polling, and checks the shared secrets against each other and
+// against crypto_kem_dec. On a one-worker pool it checks that a decaps of
+// class BIKE_PRIO_HIGH overtakes a backlog of BIKE_PRIO_LOW keygens. Prints
+// the decaps throughput of every pool against crypto_kem_dec in a loop.
+
+#define NUM_OF_ASYNC_TESTS 16
+#define NUM_OF_BACKLOG_KEYGENS 8
+#define NUM_OF_TIMED_DECAPS 64
+
+typedef struct async_keys_s
+{
+    pk_t pk[NUM_OF_ASYNC_TESTS];
+    sk_t sk[NUM_OF_ASYNC_TESTS];
+    ct_t ct[NUM_OF_ASYNC_TESTS];
+    ss_t k_enc[NUM_OF_ASYNC_TESTS];
+    ss_t k_dec[NUM_OF_ASYNC_TESTS];
+    bike_job_t job[NUM_OF_ASYNC_TESTS];
+} async_keys_t;
+
+// Completion counter of the callbacks; arg receives the count at the time.
+static uint32_t g_completed = 0;
+
+static void on_done(IN int res, IN void* arg)
+{
+    const uint32_t order = __atomic_fetch_add(&g_completed, 1, __ATOMIC_ACQ_REL);
+    if (arg != NULL)
+    {
+        *(uint32_t*)arg = (res == SUCCESS) ? order : UINT32_MAX;
+    }
+}
+
+static uint32_t check_jobs(IN bike_kem_pool_t* pool, IN OUT async_keys_t* k)
+{
+    uint32_t failures = 0;
+    ss_t k_ref = {0};
+
+    // keygen with callbacks, waited for
+    for (uint32_t i = 0; i < NUM_OF_ASYNC_TESTS; i++)
+    {
+        failures += (bike_kem_submit_keypair(pool, &k->job[i], BIKE_PRIO_LOW,
+            k->pk[i].raw, (unsigned char*)&k->sk[i], on_done, NULL) != SUCCESS);
+    }
+    for (uint32_t i = 0; i < NUM_OF_ASYNC_TESTS; i++)
+    {
+        failures += (bike_job_wait(pool, &k->job[i]) != SUCCESS);
+    }
+
+    // encaps, waited for
+    for (uint32_t i = 0; i < NUM_OF_ASYNC_TESTS; i++)
+    {
+        failures += (bike_kem_submit_enc(pool, &k->job[i], BIKE_PRIO_NORMAL,
+            k->ct[i].raw, k->k_enc[i].raw, k->pk[i].raw, NULL, NULL) != SUCCESS);
+    }
+    for (uint32_t i = 0; i < NUM_OF_ASYNC_TESTS; i++)
+    {
+        failures += (bike_job_wait(pool, &k->job[i]) != SUCCESS);
+    }
+
+    // decaps, polled for
+    for (uint32_t i = 0; i < NUM_OF_ASYNC_TESTS; i++)
+    {
+        failures += (bike_kem_submit_dec(pool, &k->job[i], BIKE_PRIO_HIGH,
+            k->k_dec[i].raw, k->ct[i].raw, (unsigned char*)&k->sk[i], NULL, NULL) != SUCCESS);
+    }
+    for (uint32_t i = 0; i < NUM_OF_ASYNC_TESTS; i++)
+    {
+        int res;
+        while ((res = bike_job_poll(&k->job[i])) == BIKE_JOB_PENDING)
+        {
+            usleep(100);
+        }
+
+        crypto_kem_dec(k_ref.raw, k->ct[i].raw, (unsigned char*)&k->sk[i]);
+        if ((res != SUCCESS) || memcmp(k->k_enc[i].raw, k->k_dec[i].raw, sizeof(ss_t)) ||
+            memcmp(k_ref.raw, k->k_dec[i].raw, sizeof(ss_t)))
+        {
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+// A decaps queued behind NUM_OF_BACKLOG_KEYGENS keygens on one worker may
+// only wait for the keygen already running.
+static uint32_t check_priority(IN const pk_t* pk, IN const sk_t* sk)
+{
+    static pk_t pk_out[NUM_OF_BACKLOG_KEYGENS];
+    static sk_t sk_out[NUM_OF_BACKLOG_KEYGENS];
+    bike_job_t keygen[NUM_OF_BACKLOG_KEYGENS];
+    bike_job_t dec;
+    ct_t ct = {0};
+    ss_t k_enc = {0};
+    ss_t k_dec = {0};
+    uint32_t dec_order = UINT32_MAX;
+    uint32_t failures = 0;
+
+    bike_kem_pool_t* pool = bike_kem_pool_create(1);
+    if (pool == NULL)
+    {
+        return 1;
+    }
+
+    crypto_kem_enc(ct.raw, k_enc.raw, pk->raw);
+    __atomic_store_n(&g_completed, 0, __ATOMIC_RELEASE);
+    for (uint32_t i = 0; i < NUM_OF_BACKLOG_KEYGENS; i++)
+    {
+        failures += (bike_kem_submit_keypair(pool, &keygen[i], BIKE_PRIO_LOW,
+            pk_out[i].raw, (unsigned char*)&sk_out[i], on_done, NULL) != SUCCESS);
+    }
+    failures += (bike_kem_submit_dec(pool, &dec, BIKE_PRIO_HIGH,
+        k_dec.raw, ct.raw, (const unsigned char*)sk, on_done, &dec_order) != SUCCESS);
+    const uint32_t completed_at_submit = __atomic_load_n(&g_completed, __ATOMIC_ACQUIRE);
+
+    // destroy runs the backlog first
+    bike_kem_pool_destroy(pool);
+
+    if ((dec_order == UINT32_MAX) || (dec_order > completed_at_submit + 1) ||
+        memcmp(k_enc.raw, k_dec.raw, sizeof(ss_t)) ||
+        (__atomic_load_n(&g_completed, __ATOMIC_ACQUIRE) != NUM_OF_BACKLOG_KEYGENS + 1))
+    {
+        failures++;
+    }
+    MSG("  priority: decaps completed %u of %u (%u keygens done when it was queued)\n",
+        dec_order + 1, NUM_OF_BACKLOG_KEYGENS + 1, completed_at_submit);
+
+    return failures;
+}
+
+// Decaps per second on pool, or with crypto_kem_dec in a loop (NULL).
+static double time_decaps(IN bike_kem_pool_t* pool,
+        IN const pk_t* pk,
+        IN const sk_t* sk)
+{
+    static bike_job_t job[NUM_OF_TIMED_DECAPS];
+    static ss_t k[NUM_OF_TIMED_DECAPS];
+    ct_t ct = {0};
+
+    crypto_kem_enc(ct.raw, k[0].raw, pk->raw);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < NUM_OF_TIMED_DECAPS; t++)
+    {
+        if (pool == NULL)
+        {
+            crypto_kem_dec(k[t].raw, ct.raw, (const unsigned char*)sk);
+        }
+        else
+        {
+            bike_kem_submit_dec(pool, &job[t], BIKE_PRIO_HIGH, k[t].raw, ct.raw,
+                (const unsigned char*)sk, NULL, NULL);
+        }
+    }
+    for (uint32_t t = 0; (pool != NULL) && (t < NUM_OF_TIMED_DECAPS); t++)
+    {
+        bike_job_wait(pool, &job[t]);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    return NUM_OF_TIMED_DECAPS / std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    sk_t sk = {0};
+    pk_t pk = {0};
+    uint32_t threads[16];
+    uint32_t n_counts = 0;
+    uint32_t failures = 0;
+
+    if (argc > 1)
+    {
+        for (int i = 1; (i < argc) && (n_counts < 16); i++)
+        {
+            threads[n_counts++] = (uint32_t)atoi(argv[i]);
+        }
+    }
+    else
+    {
+        const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        const uint32_t defaults[] = {1, 2, 4, (ncpu > 0) ? (uint32_t)ncpu : 1};
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            if ((i < 3) || (defaults[i] > 4))
+            {
+                threads[n_counts++] = defaults[i];
+            }
+        }
+    }
+
+    async_keys_t* keys = (async_keys_t*)malloc(sizeof(async_keys_t));
+    if ((keys == NULL) || (bike_init() != SUCCESS) ||
+        (crypto_kem_keypair(pk.raw, (unsigned char*)&sk) != SUCCESS))
+    {
+        MSG("Setup failed\n");
+        return 1;
+    }
+
+    MSG("BIKE async job test, r: %d\n", (int)R_BITS);
+    failures += check_priority(&pk, &sk);
+    const double rate_ref = time_decaps(NULL, &pk, &sk);
+    MSG("  decaps crypto_kem_dec: %.1f/s\n", rate_ref);
+
+    for (uint32_t c = 0; c < n_counts; c++)
+    {
+        bike_kem_pool_t* pool = bike_kem_pool_create(threads[c]);
+        if (pool == NULL)
+        {
+            MSG("  %u threads: cannot create the pool\n", threads[c]);
+            failures++;
+            continue;
+        }
+
+        const uint32_t bad = check_jobs(pool, keys);
+        const double rate = time_decaps(pool, &pk, &sk);
+
+        MSG("  %u threads: failed jobs %u/%u, decaps %.1f/s (x%.2f)\n",
+            threads[c], bad, 3*NUM_OF_ASYNC_TESTS, rate, rate / rate_ref);
+        failures += bad;
+
+        bike_kem_pool_destroy(pool);
+    }
+
+    free(keys);
+
+    MSG("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kem.h"
+#include "threshold.h"
+
+// Checks the Backflip decoder (decode_backflip.c): its tabulated threshold
+// against compute_threshold, and crypto_kem_dec_backflip against the
+// encapsulated secret and crypto_kem_dec on valid and tampered ciphertexts.
+
+#define NUM_OF_KEYS 4
+#define NUM_OF_CTS_PER_KEY 8
+#define THRESHOLD_WEIGHT_STEP 7
+
+static uint32_t check_threshold_table(void)
+{
+    static double lnbino_d[DV + 1];
+    static double iks_t[T1 + 1];
+    threshold_table_t tab;
+    uint32_t mismatches = 0;
+
+    threshold_table_init(&tab, R_BITS, N_BITS, DV, 2*DV, T1, lnbino_d, iks_t);
+    for (uint32_t t = 1; t <= T1; t++)
+    {
+        for (uint32_t S = 0; S <= R_BITS; S += THRESHOLD_WEIGHT_STEP)
+        {
+            if (threshold_table_compute(&tab, S, t) !=
+                compute_threshold(R_BITS, N_BITS, DV, 2*DV, S, t))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+static uint32_t check_decaps(void)
+{
+    sk_t sk = {0};
+    pk_t pk = {0};
+    ct_t ct = {0};
+    ss_t k_enc = {0};
+    ss_t k_bgf = {0};
+    ss_t k_bf = {0};
+    uint32_t mismatches = 0;
+
+    for (uint32_t k = 0; k < NUM_OF_KEYS; k++)
+    {
+        if (crypto_kem_keypair(pk.raw, (unsigned char*)&sk) != SUCCESS)
+        {
+            return 1;
+        }
+
+        for (uint32_t i = 0; i < NUM_OF_CTS_PER_KEY; i++)
+        {
+            const int tampered = (i % 2 == 1);
+
+            crypto_kem_enc(ct.raw, k_enc.raw, pk.raw);
+            for (uint32_t f = 0; tampered && (f < 8 + i); f++)
+            {
+                const uint32_t bit = rand() % R_BITS;
+                ct.val0[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+            }
+
+            if ((crypto_kem_dec(k_bgf.raw, ct.raw, (const unsigned char*)&sk) != SUCCESS) ||
+                (crypto_kem_dec_backflip(k_bf.raw, ct.raw, (const unsigned char*)&sk) != SUCCESS) ||
+                memcmp(k_bf.raw, k_bgf.raw, sizeof(ss_t)) ||
+                (!tampered && memcmp(k_bf.raw, k_enc.raw, sizeof(ss_t))))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+int main(void)
+{
+    uint32_t failures = 0;
+
+    MSG("BIKE Backflip test, r: %d\n", (int)R_BITS);
+
+    const uint32_t bad_threshold = check_threshold_table();
+    MSG("  threshold table: mismatches %u\n", bad_threshold);
+    failures += bad_threshold;
+
+    const uint32_t bad_decaps = check_decaps();
+    MSG("  crypto_kem_dec_backflip: mismatches %u of %u\n", bad_decaps,
+        NUM_OF_KEYS * NUM_OF_CTS_PER_KEY);
+    failures += bad_decaps;
+
+    MSG("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
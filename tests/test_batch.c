@@ -0,0 +1,259 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "kem.h"
+#include "dispatch.h"
+#include "keccak_multi.h"
+#include "FromNIST/rng.h"
+
+// Checks crypto_kem_enc_batch against sequential crypto_kem_enc calls on the
+// same DRBG seed, for n = 1..NUM_OF_ENC_BATCH on every backend the CPU
+// supports (one child process per backend, as the backend is bound once per
+// process). Then checks crypto_kem_dec_batch against crypto_kem_dec on
+// batches of valid and tampered ciphertexts of every size up to
+// NUM_OF_BATCH_CTS, and prints the decaps latency of both.
+
+#define NUM_OF_BATCH_CTS 20
+#define NUM_OF_TIMED_BATCHES 4
+#define NUM_OF_ENC_BATCH 10
+#define NUM_OF_ENC_KEYS 3
+
+// BIKE_BACKEND values, in the order of bike_backend_t
+static const char* const g_backend_names[BIKE_BACKEND_COUNT] = {
+    "portable", "pclmul", "avx2", "avx512", "neon"};
+
+typedef struct enc_buffers_s
+{
+    pk_t pk[NUM_OF_ENC_KEYS];
+    sk_t sk[NUM_OF_ENC_KEYS];
+    ct_t ct_ref[NUM_OF_ENC_BATCH];
+    ss_t k_ref[NUM_OF_ENC_BATCH];
+    ct_t ct_batch[NUM_OF_ENC_BATCH];
+    ss_t k_batch[NUM_OF_ENC_BATCH];
+    const unsigned char* pk_in[NUM_OF_ENC_BATCH];
+    unsigned char* ct_out[NUM_OF_ENC_BATCH];
+    unsigned char* ss_out[NUM_OF_ENC_BATCH];
+} enc_buffers_t;
+
+typedef struct batch_buffers_s
+{
+    ct_t ct[NUM_OF_BATCH_CTS];
+    ss_t k_enc[NUM_OF_BATCH_CTS];
+    ss_t k_ref[NUM_OF_BATCH_CTS];
+    ss_t k_batch[NUM_OF_BATCH_CTS];
+    const unsigned char* ct_in[NUM_OF_BATCH_CTS];
+    unsigned char* ss_out[NUM_OF_BATCH_CTS];
+} batch_buffers_t;
+
+static uint32_t check_dec_batch(IN OUT batch_buffers_t* b,
+        IN const pk_t* pk,
+        IN const sk_t* sk)
+{
+    uint32_t mismatches = 0;
+
+    for (uint32_t i = 0; i < NUM_OF_BATCH_CTS; i++)
+    {
+        crypto_kem_enc(b->ct[i].raw, b->k_enc[i].raw, pk->raw);
+        // every third ciphertext gets random bit flips in c0
+        for (uint32_t f = 0; (i % 3 == 1) && (f < 8 + i); f++)
+        {
+            const uint32_t bit = rand() % R_BITS;
+            b->ct[i].val0[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+        }
+        crypto_kem_dec(b->k_ref[i].raw, b->ct[i].raw, (const unsigned char*)sk);
+        b->ct_in[i] = b->ct[i].raw;
+        b->ss_out[i] = b->k_batch[i].raw;
+    }
+
+    for (uint32_t n = 1; n <= NUM_OF_BATCH_CTS; n++)
+    {
+        memset(b->k_batch, 0, sizeof(b->k_batch));
+        if (crypto_kem_dec_batch(b->ss_out, b->ct_in, (const unsigned char*)sk, n) != SUCCESS)
+        {
+            mismatches++;
+            continue;
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (memcmp(b->k_ref[i].raw, b->k_batch[i].raw, sizeof(ss_t)) ||
+                ((i % 3 != 1) && memcmp(b->k_enc[i].raw, b->k_batch[i].raw, sizeof(ss_t))))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+static uint32_t check_enc_batch(void)
+{
+    unsigned char entropy[48];
+    uint32_t mismatches = 0;
+
+    enc_buffers_t* b = (enc_buffers_t*)calloc(1, sizeof(enc_buffers_t));
+    if (b == NULL)
+    {
+        return 1;
+    }
+
+    for (uint32_t k = 0; k < NUM_OF_ENC_KEYS; k++)
+    {
+        if (crypto_kem_keypair(b->pk[k].raw, (unsigned char*)&b->sk[k]) != SUCCESS)
+        {
+            free(b);
+            return 1;
+        }
+    }
+    for (uint32_t i = 0; i < NUM_OF_ENC_BATCH; i++)
+    {
+        b->pk_in[i] = b->pk[i % NUM_OF_ENC_KEYS].raw;
+        b->ct_out[i] = b->ct_batch[i].raw;
+        b->ss_out[i] = b->k_batch[i].raw;
+    }
+
+    for (uint32_t n = 1; n <= NUM_OF_ENC_BATCH; n++)
+    {
+        memset(entropy, (int)n, sizeof(entropy));
+        randombytes_init(entropy, NULL, 256);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            crypto_kem_enc(b->ct_ref[i].raw, b->k_ref[i].raw, b->pk_in[i]);
+        }
+
+        randombytes_init(entropy, NULL, 256);
+        if (crypto_kem_enc_batch(b->ct_out, b->ss_out, b->pk_in, n) != SUCCESS)
+        {
+            mismatches++;
+            continue;
+        }
+
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (memcmp(b->ct_ref[i].raw, b->ct_batch[i].raw, sizeof(ct_t)) ||
+                memcmp(b->k_ref[i].raw, b->k_batch[i].raw, sizeof(ss_t)))
+            {
+                mismatches++;
+            }
+        }
+    }
+
+    free(b);
+    return mismatches;
+}
+
+// Runs check_enc_batch in a child process with BIKE_BACKEND=name.
+static uint32_t check_enc_batch_backend(IN const char* name)
+{
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        setenv("BIKE_BACKEND", name, 1);
+        const uint32_t mismatches = check_enc_batch();
+        MSG("  crypto_kem_enc_batch (%s, KECCAK_LANES %d): mismatches %u\n",
+            bike_dispatch()->name, (int)KECCAK_LANES, mismatches);
+        fflush(stdout);
+        _exit(mismatches ? 1 : 0);
+    }
+
+    int status = 0;
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+    {
+        return 1;
+    }
+    return (WIFEXITED(status) && (WEXITSTATUS(status) == 0)) ? 0 : 1;
+}
+
+int main(void)
+{
+    sk_t sk = {0};
+    pk_t pk = {0};
+    uint32_t failures = 0;
+
+    MSG("BIKE batch test, r: %d\n", (int)R_BITS);
+
+    // before any KEM call binds the backend of this process
+    for (uint32_t be = 0; be < BIKE_BACKEND_COUNT; be++)
+    {
+        if (bike_backend_supported((bike_backend_t)be))
+        {
+            failures += check_enc_batch_backend(g_backend_names[be]);
+        }
+    }
+
+    batch_buffers_t* b = (batch_buffers_t*)malloc(sizeof(batch_buffers_t));
+    if ((b == NULL) || (crypto_kem_keypair(pk.raw, (unsigned char*)&sk) != SUCCESS))
+    {
+        MSG("Setup failed\n");
+        return 1;
+    }
+
+    const uint32_t bad_dec = check_dec_batch(b, &pk, &sk);
+    MSG("  crypto_kem_dec_batch: mismatches %u\n", bad_dec);
+    failures += bad_dec;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < NUM_OF_TIMED_BATCHES; t++)
+    {
+        for (uint32_t i = 0; i < NUM_OF_BATCH_CTS; i++)
+        {
+            crypto_kem_dec(b->ss_out[i], b->ct_in[i], (const unsigned char*)&sk);
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < NUM_OF_TIMED_BATCHES; t++)
+    {
+        crypto_kem_dec_batch(b->ss_out, b->ct_in, (const unsigned char*)&sk, NUM_OF_BATCH_CTS);
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+    const double calls = NUM_OF_TIMED_BATCHES * NUM_OF_BATCH_CTS;
+    MSG("  decaps per ciphertext: crypto_kem_dec %.1f us, crypto_kem_dec_batch %.1f us\n",
+        std::chrono::duration<double, std::micro>(t1 - t0).count() / calls,
+        std::chrono::duration<double, std::micro>(t2 - t1).count() / calls);
+
+    free(b);
+
+    MSG("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flip_queue.h"
+
+// Checks the flip queue of the Backflip decoder (flip_queue.h): insert,
+// remove, pop of the expired positions, reset and a full pool, then a run
+// of random operations against a plain array of expiries.
+
+#define NUM_OF_RANDOM_OPS 200000
+#define NO_EXPIRY 0
+
+static uint32_t g_failures = 0;
+
+static void check(IN const int cond, IN const char* what)
+{
+    if (!cond)
+    {
+        MSG("  failed: %s\n", what);
+        g_failures++;
+    }
+}
+
+// Pops every position expiring at it; returns their count, and checks
+// that each one was queued to expire then.
+static uint32_t pop_all(IN OUT flip_queue_t* q,
+        IN OUT uint32_t* expiry,
+        IN const uint32_t it)
+{
+    uint32_t count = 0;
+    for (uint32_t j = fq_pop_expired(q, it); j != FQ_NIL; j = fq_pop_expired(q, it))
+    {
+        check((j < N_BITS) && (expiry[j] == it), "popped position expires now");
+        check(!fq_contains(q, j), "popped position is not queued");
+        if (j < N_BITS)
+        {
+            expiry[j] = NO_EXPIRY;
+        }
+        count++;
+    }
+    return count;
+}
+
+static void check_basic(IN OUT flip_queue_t* q, IN OUT uint32_t* expiry)
+{
+    fq_reset(q);
+    check((q->length == 0) && (fq_pop_expired(q, 1) == FQ_NIL), "empty queue");
+
+    // three positions in one bucket, one in the next
+    const uint32_t pos[4] = {0, 17, N_BITS - 1, 5};
+    const uint32_t exp[4] = {3, 3, 3, 4};
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        check(fq_insert(q, pos[i], exp[i]) == 0, "insert");
+        expiry[pos[i]] = exp[i];
+    }
+    check((q->length == 4) && fq_contains(q, 17) && !fq_contains(q, 18), "contains");
+
+    // remove from the middle of the bucket list, then its head
+    fq_remove(q, 17);
+    expiry[17] = NO_EXPIRY;
+    fq_remove(q, N_BITS - 1);
+    expiry[N_BITS - 1] = NO_EXPIRY;
+    check((q->length == 2) && !fq_contains(q, 17), "remove");
+
+    check(pop_all(q, expiry, 2) == 0, "nothing expires at 2");
+    check(pop_all(q, expiry, 3) == 1, "one position expires at 3");
+    check(pop_all(q, expiry, 4) == 1, "one position expires at 4");
+    check(q->length == 0, "queue drained");
+
+    // expiries wrap around the wheel
+    check(fq_insert(q, 9, 4 + FLIP_QUEUE_WHEEL - 1) == 0, "insert at the wheel size");
+    expiry[9] = 4 + FLIP_QUEUE_WHEEL - 1;
+    check(pop_all(q, expiry, 4 + FLIP_QUEUE_WHEEL - 1) == 1, "wrapped expiry");
+
+    // a full pool rejects the insert and leaves the queue unchanged
+    for (uint32_t j = 0; j < FLIP_QUEUE_CAPACITY; j++)
+    {
+        check(fq_insert(q, j, 1 + (j % 5)) == 0, "fill the pool");
+    }
+    check(fq_insert(q, FLIP_QUEUE_CAPACITY, 1) != 0, "full pool");
+    check((q->length == FLIP_QUEUE_CAPACITY) && !fq_contains(q, FLIP_QUEUE_CAPACITY),
+          "full pool unchanged");
+
+    // reset empties the queue and returns all nodes
+    fq_reset(q);
+    check((q->length == 0) && !fq_contains(q, 0) && (fq_pop_expired(q, 1) == FQ_NIL), "reset");
+    for (uint32_t j = 0; j < FLIP_QUEUE_CAPACITY; j++)
+    {
+        check(fq_insert(q, N_BITS - 1 - j, 2) == 0, "refill after reset");
+    }
+    fq_reset(q);
+    memset(expiry, 0, N_BITS * sizeof(uint32_t));
+}
+
+// Random operations in the pattern of the decoder: at iteration it, pop
+// the expired positions, then flip random positions (remove if queued,
+// else insert with a time to live of 1..FLIP_QUEUE_WHEEL-1).
+static void check_random(IN OUT flip_queue_t* q, IN OUT uint32_t* expiry)
+{
+    uint32_t it = 1;
+    uint32_t queued = 0;
+
+    fq_reset(q);
+    for (uint32_t op = 0; op < NUM_OF_RANDOM_OPS; it++)
+    {
+        queued -= pop_all(q, expiry, it);
+
+        const uint32_t flips = (uint32_t)(rand() % 64);
+        for (uint32_t f = 0; f < flips; f++, op++)
+        {
+            // a small range makes removals frequent
+            const uint32_t j = (uint32_t)(rand() % (2 * FLIP_QUEUE_CAPACITY));
+            check(fq_contains(q, j) == (expiry[j] != NO_EXPIRY), "contains matches");
+            if (expiry[j] != NO_EXPIRY)
+            {
+                fq_remove(q, j);
+                expiry[j] = NO_EXPIRY;
+                queued--;
+            }
+            else if (queued < FLIP_QUEUE_CAPACITY)
+            {
+                expiry[j] = it + 1 + (uint32_t)(rand() % (FLIP_QUEUE_WHEEL - 1));
+                check(fq_insert(q, j, expiry[j]) == 0, "insert");
+                queued++;
+            }
+        }
+        check(q->length == queued, "length matches");
+    }
+
+    // every queued position expires within the wheel
+    for (uint32_t k = 0; k < FLIP_QUEUE_WHEEL - 1; k++)
+    {
+        queued -= pop_all(q, expiry, it + k);
+    }
+    check((queued == 0) && (q->length == 0), "all positions expired");
+}
+
+int main(void)
+{
+    flip_queue_t* q = fq_alloc();
+    uint32_t* expiry = (uint32_t*)calloc(N_BITS, sizeof(uint32_t));
+    if ((q == NULL) || (expiry == NULL))
+    {
+        MSG("Allocation failed\n");
+        return 1;
+    }
+
+    MSG("BIKE flip queue test, n: %d, capacity: %u, %u bytes\n", (int)N_BITS,
+        (uint32_t)FLIP_QUEUE_CAPACITY, (uint32_t)sizeof(flip_queue_t));
+
+    check_basic(q, expiry);
+    check_random(q, expiry);
+
+    fq_free(q);
+    free(expiry);
+
+    MSG("%s\n", g_failures ? "FAILED" : "OK");
+    return g_failures ? 1 : 0;
+}
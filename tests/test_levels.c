@@ -0,0 +1,90 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "levels/bike_kem.h"
+
+#define NUM_OF_LEVEL_TESTS 3
+
+////////////////////////////////////////////////////////////////
+//   Main function for testing all levels in one binary
+////////////////////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+    const uint32_t levels[] = {1, 3, 5};
+    int failures = 0;
+
+    for (uint32_t l = 0; l < sizeof(levels)/sizeof(levels[0]); l++)
+    {
+        const bike_kem_t* kem = bike_kem(levels[l]);
+
+        unsigned char* pk = (unsigned char*)malloc(kem->pk_bytes);
+        unsigned char* sk = (unsigned char*)malloc(kem->sk_bytes);
+        unsigned char* ct = (unsigned char*)malloc(kem->ct_bytes);
+        unsigned char* k_enc = (unsigned char*)malloc(kem->ss_bytes);
+        unsigned char* k_dec = (unsigned char*)malloc(kem->ss_bytes);
+
+        printf("Level %u (r: %u, pk: %zu, ct: %zu bytes)\n", kem->level,
+                kem->r_bits, kem->pk_bytes, kem->ct_bytes);
+
+        for (uint32_t i = 1; i <= NUM_OF_LEVEL_TESTS; i++)
+        {
+            if ((kem->keypair(pk, sk) != 0) ||
+                (kem->enc(ct, k_enc, pk) != 0) ||
+                (kem->dec(k_dec, ct, sk) != 0) ||
+                (memcmp(k_enc, k_dec, kem->ss_bytes) != 0))
+            {
+                printf("  test %u: Failure!\n", i);
+                failures++;
+            }
+            else
+            {
+                printf("  test %u: Success! decapsulated key is the same as encapsulated key!\n", i);
+            }
+        }
+
+        free(pk);
+        free(sk);
+        free(ct);
+        free(k_enc);
+        free(k_dec);
+    }
+
+    return failures;
+}
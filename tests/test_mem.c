@@ -0,0 +1,137 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kem.h"
+#include "tools/mem_profile.h"
+
+// Peak RAM of every API call: the high-water mark of the stack it runs on
+// plus the peak of the heap it allocates (workspace and OpenSSL included),
+// measured by tools/mem_profile.h. The cost of an empty thread is
+// subtracted.
+
+#define NUM_OF_MEM_TESTS 3
+
+typedef enum
+{
+    MEM_EMPTY = 0,
+    MEM_KEYPAIR,
+    MEM_ENC,
+    MEM_DEC
+} mem_call_t;
+
+static unsigned char pk[sizeof(pk_t)];
+static unsigned char sk[sizeof(sk_t)];
+static unsigned char ct[sizeof(ct_t)];
+static unsigned char k_enc[sizeof(ss_t)];
+static unsigned char k_dec[sizeof(ss_t)];
+
+static void* run_call(void* arg)
+{
+    int rc = 0;
+
+    switch (*(mem_call_t*)arg)
+    {
+        case MEM_KEYPAIR: rc = crypto_kem_keypair(pk, sk); break;
+        case MEM_ENC:     rc = crypto_kem_enc(ct, k_enc, pk); break;
+        case MEM_DEC:     rc = crypto_kem_dec(k_dec, ct, sk); break;
+        default: break;
+    }
+
+    return (void*)(intptr_t)rc;
+}
+
+// Run one call on a painted stack; returns its status.
+static int measure(IN mem_call_t call, OUT mem_usage_t* usage)
+{
+    return mem_profile_run(run_call, &call, usage);
+}
+
+////////////////////////////////////////////////////////////////
+//   Main function for measuring peak RAM per API call
+////////////////////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+    const char* names[] = {"", "crypto_kem_keypair", "crypto_kem_enc", "crypto_kem_dec"};
+    mem_usage_t peak[4] = {{0, 0, 0}};
+    mem_usage_t empty;
+    int failures = 0;
+
+    // one unmeasured round for the one-time setup (OpenSSL, dispatch)
+    measure(MEM_KEYPAIR, &empty);
+    measure(MEM_ENC, &empty);
+    measure(MEM_DEC, &empty);
+    measure(MEM_EMPTY, &empty);
+
+    for (uint32_t i = 1; i <= NUM_OF_MEM_TESTS; i++)
+    {
+        for (uint32_t c = MEM_KEYPAIR; c <= MEM_DEC; c++)
+        {
+            mem_usage_t usage;
+            if (measure((mem_call_t)c, &usage) != 0)
+            {
+                printf("test %u: %s failed!\n", i, names[c]);
+                failures++;
+            }
+            mem_usage_peak(&peak[c], usage, &empty);
+        }
+
+        if (memcmp(k_enc, k_dec, sizeof(ss_t)) != 0)
+        {
+            printf("test %u: Failure! decapsulated key differs\n", i);
+            failures++;
+        }
+    }
+
+#ifdef BIKE_LOW_MEM
+    printf("Profile: BIKE_LOW_MEM, r = %u\n", (uint32_t)R_BITS);
+#else
+    printf("Profile: default, r = %u\n", (uint32_t)R_BITS);
+#endif
+    printf("Decaps workspace: %zu bytes\n", bike_ws_size());
+    printf("Peak RAM per call (bytes, max of %u runs):\n", NUM_OF_MEM_TESTS);
+    printf("  %-20s %10s %10s %10s %8s\n", "call", "stack", "heap", "total", "allocs");
+    for (uint32_t c = MEM_KEYPAIR; c <= MEM_DEC; c++)
+    {
+        printf("  %-20s %10zu %10zu %10zu %8zu\n", names[c], peak[c].stack, peak[c].heap,
+                peak[c].stack + peak[c].heap, peak[c].allocs);
+    }
+
+    return failures;
+}
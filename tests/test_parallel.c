@@ -0,0 +1,217 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include "kem.h"
+#include "decode.h"
+#include "decode_parallel.h"
+
+// Checks BGF_decoder_parallel_ws against BGF_decoder_ws on random syndromes
+// of several weights, and crypto_kem_dec_parallel against crypto_kem_dec
+// on valid and tampered ciphertexts, for 1, 2, 4 and all online CPUs (or
+// the thread counts given on the command line). Prints the decaps latency.
+
+#define NUM_OF_PARALLEL_TESTS 20
+#define NUM_OF_TIMED_DECAPS 50
+
+static uint32_t check_decoder(IN bike_decode_pool_t* pool,
+        IN bike_ws_t* ws_ref,
+        IN bike_ws_t* ws_par,
+        IN const sk_t* sk)
+{
+    static uint8_t s_ref[R_BITS], s_par[R_BITS];
+    static uint8_t e_ref[2*R_BITS], e_par[2*R_BITS];
+    uint32_t h0_compact[DV], h1_compact[DV];
+    uint32_t mismatches = 0;
+
+    convert2compact(h0_compact, sk->val0);
+    convert2compact(h1_compact, sk->val1);
+
+    for (uint32_t t = 0; t < NUM_OF_PARALLEL_TESTS; t++)
+    {
+        // from nearly empty syndromes up to ones the decoder cannot handle
+        const uint32_t weight = 1 + (t * (R_BITS / 2)) / NUM_OF_PARALLEL_TESTS;
+        memset(s_ref, 0, R_BITS);
+        for (uint32_t i = 0; i < weight; i++)
+        {
+            s_ref[rand() % R_BITS] = 1;
+        }
+        memcpy(s_par, s_ref, R_BITS);
+
+        const int rc_ref = BGF_decoder_ws(e_ref, s_ref, h0_compact, h1_compact, ws_ref);
+        const int rc_par = BGF_decoder_parallel_ws(e_par, s_par, h0_compact, h1_compact, pool, ws_par);
+
+        if ((rc_ref != rc_par) || memcmp(e_ref, e_par, 2*R_BITS) || memcmp(s_ref, s_par, R_BITS))
+        {
+            mismatches++;
+        }
+    }
+
+    return mismatches;
+}
+
+static uint32_t check_decaps(IN bike_decode_pool_t* pool,
+        IN const pk_t* pk,
+        IN const sk_t* sk)
+{
+    ct_t ct = {0};
+    ss_t k_enc = {0};
+    ss_t k_ref = {0};
+    ss_t k_par = {0};
+    uint32_t mismatches = 0;
+
+    for (uint32_t t = 0; t < NUM_OF_PARALLEL_TESTS; t++)
+    {
+        crypto_kem_enc(ct.raw, k_enc.raw, pk->raw);
+        // every other ciphertext gets t random bit flips in c0
+        for (uint32_t i = 0; (t & 1) && (i < t * 8); i++)
+        {
+            const uint32_t bit = rand() % R_BITS;
+            ct.val0[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+        }
+
+        const int rc_ref = crypto_kem_dec(k_ref.raw, ct.raw, sk->raw);
+        const int rc_par = crypto_kem_dec_parallel(k_par.raw, ct.raw, sk->raw, pool);
+
+        if ((rc_ref != rc_par) || memcmp(k_ref.raw, k_par.raw, sizeof(ss_t)) ||
+            (!(t & 1) && memcmp(k_enc.raw, k_par.raw, sizeof(ss_t))))
+        {
+            mismatches++;
+        }
+    }
+
+    return mismatches;
+}
+
+static double time_decaps(IN bike_decode_pool_t* pool,
+        IN const pk_t* pk,
+        IN const sk_t* sk)
+{
+    ct_t ct = {0};
+    ss_t k = {0};
+
+    crypto_kem_enc(ct.raw, k.raw, pk->raw);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < NUM_OF_TIMED_DECAPS; t++)
+    {
+        if (pool == NULL)
+        {
+            crypto_kem_dec(k.raw, ct.raw, sk->raw);
+        }
+        else
+        {
+            crypto_kem_dec_parallel(k.raw, ct.raw, sk->raw, pool);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / NUM_OF_TIMED_DECAPS;
+}
+
+int main(int argc, char **argv)
+{
+    sk_t sk = {0};
+    pk_t pk = {0};
+    uint32_t threads[16];
+    uint32_t n_counts = 0;
+    uint32_t failures = 0;
+
+    if (argc > 1)
+    {
+        for (int i = 1; (i < argc) && (n_counts < 16); i++)
+        {
+            threads[n_counts++] = (uint32_t)atoi(argv[i]);
+        }
+    }
+    else
+    {
+        const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        const uint32_t defaults[] = {1, 2, 4, (ncpu > 0) ? (uint32_t)ncpu : 1};
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            if ((i < 3) || (defaults[i] > 4))
+            {
+                threads[n_counts++] = defaults[i];
+            }
+        }
+    }
+
+    bike_ws_t* ws_ref = bike_ws_alloc();
+    bike_ws_t* ws_par = bike_ws_alloc();
+    if ((ws_ref == NULL) || (ws_par == NULL) || (crypto_kem_keypair(pk.raw, sk.raw) != SUCCESS))
+    {
+        MSG("Setup failed\n");
+        return 1;
+    }
+
+    MSG("BIKE parallel decoder test, r: %d\n", (int)R_BITS);
+    const double t_ref = time_decaps(NULL, &pk, &sk);
+    MSG("  decaps 1 thread (crypto_kem_dec): %.1f us\n", t_ref);
+
+    for (uint32_t c = 0; c < n_counts; c++)
+    {
+        bike_decode_pool_t* pool = bike_decode_pool_create(threads[c]);
+        if (pool == NULL)
+        {
+            MSG("  %u threads: cannot create the pool\n", threads[c]);
+            failures++;
+            continue;
+        }
+
+        const uint32_t bad_dec = check_decoder(pool, ws_ref, ws_par, &sk);
+        const uint32_t bad_kem = check_decaps(pool, &pk, &sk);
+        const double t_par = time_decaps(pool, &pk, &sk);
+
+        MSG("  %u threads: decoder mismatches %u/%u, decaps mismatches %u/%u, decaps %.1f us (x%.2f)\n",
+            threads[c], bad_dec, NUM_OF_PARALLEL_TESTS, bad_kem, NUM_OF_PARALLEL_TESTS,
+            t_par, t_ref / t_par);
+        failures += bad_dec + bad_kem;
+
+        bike_decode_pool_destroy(pool);
+    }
+
+    bike_ws_free(ws_ref);
+    bike_ws_free(ws_par);
+
+    MSG("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "kem.h"
+#include "decode_trace.h"
+
+#ifndef BIKE_DECODER_TRACE
+#error "build with -DBIKE_DECODER_TRACE (make bike-trace-test)"
+#endif
+
+// Decapsulates valid and tampered ciphertexts with the decoder trace on.
+// The callback prints every step of the first decode and sums the phase
+// times of all of them; the ring must hold the same records. Each decode
+// must record NbIter iterations, two masked ones and its end, with black
+// marks equal to the flips of every iteration.
+
+#define NUM_OF_TRACE_TESTS 10
+#define STEPS_PER_DECODE (NbIter + 3)
+
+typedef struct trace_sums_s
+{
+    uint32_t records;
+    uint32_t errors;
+    uint64_t t_counters;
+    uint64_t t_flip;
+    uint64_t t_syndrome;
+    uint64_t t_total;
+} trace_sums_t;
+
+static const char* kind_name(IN const uint32_t kind)
+{
+    switch (kind)
+    {
+    case BGF_TRACE_ITER: return "iter";
+    case BGF_TRACE_MASKED_BLACK: return "masked-black";
+    case BGF_TRACE_MASKED_GRAY: return "masked-gray";
+    default: return "end";
+    }
+}
+
+static void on_record(IN const bgf_trace_rec_t* rec, IN void* arg)
+{
+    trace_sums_t* sums = (trace_sums_t*)arg;
+    const uint32_t step = sums->records % STEPS_PER_DECODE;
+
+    if (rec->decode == 0)
+    {
+        MSG("  %-12s it %u  |s| %5u  T %3u  black %4u+%-4u gray %4u+%-4u flips %4u+%-4u "
+            "ticks: ctr %8llu flip %7llu syn %8llu\n",
+            kind_name(rec->kind), rec->iter, rec->syndrome_weight, rec->threshold,
+            rec->black[0], rec->black[1], rec->gray[0], rec->gray[1], rec->flips[0], rec->flips[1],
+            (unsigned long long)rec->t_counters, (unsigned long long)rec->t_flip,
+            (unsigned long long)rec->t_syndrome);
+    }
+
+    // steps in order: iteration 1, the masked ones, iterations 2..NbIter, end
+    const uint32_t kind = (step == 1) ? BGF_TRACE_MASKED_BLACK : (step == 2) ? BGF_TRACE_MASKED_GRAY :
+            (step == STEPS_PER_DECODE - 1) ? BGF_TRACE_END : BGF_TRACE_ITER;
+    const uint32_t iter = (step < 3) ? 1 : (step == STEPS_PER_DECODE - 1) ? NbIter : step - 1;
+    if ((rec->decode != sums->records / STEPS_PER_DECODE) || (rec->kind != kind) || (rec->iter != iter) ||
+        ((kind == BGF_TRACE_ITER) && ((rec->black[0] != rec->flips[0]) || (rec->black[1] != rec->flips[1]))))
+    {
+        sums->errors++;
+    }
+
+    sums->records++;
+    sums->t_counters += rec->t_counters;
+    sums->t_flip += rec->t_flip;
+    sums->t_syndrome += rec->t_syndrome;
+    sums->t_total += rec->t_total;
+}
+
+int main(int argc, char **argv)
+{
+    sk_t sk = {0};
+    pk_t pk = {0};
+    ct_t ct = {0};
+    ss_t k_enc = {0};
+    ss_t k_dec = {0};
+    trace_sums_t sums = {0};
+    bgf_trace_rec_t ring[BGF_TRACE_RING];
+    uint32_t failures = 0;
+
+    if (crypto_kem_keypair(pk.raw, sk.raw) != SUCCESS)
+    {
+        MSG("Keypair failed\n");
+        return 1;
+    }
+
+    MSG("BIKE decoder trace test, r: %d\n", (int)R_BITS);
+    bgf_trace_set_callback(on_record, &sums);
+
+    for (uint32_t t = 0; t < NUM_OF_TRACE_TESTS; t++)
+    {
+        crypto_kem_enc(ct.raw, k_enc.raw, pk.raw);
+        // every other ciphertext gets 32 random bit flips in c0
+        for (uint32_t i = 0; (t & 1) && (i < 32); i++)
+        {
+            const uint32_t bit = rand() % R_BITS;
+            ct.val0[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+        }
+        crypto_kem_dec(k_dec.raw, ct.raw, sk.raw);
+
+        // the ring holds the records of this decode only
+        const uint32_t n = bgf_trace_read(ring, BGF_TRACE_RING);
+        if ((n != STEPS_PER_DECODE) || (ring[n - 1].kind != BGF_TRACE_END) || (ring[0].decode != t) ||
+            (!(t & 1) && (ring[n - 1].syndrome_weight != 0)))
+        {
+            failures++;
+        }
+    }
+    bgf_trace_set_callback(NULL, NULL);
+
+    failures += sums.errors + (sums.records != NUM_OF_TRACE_TESTS * STEPS_PER_DECODE) + (bgf_trace_dropped() != 0);
+
+    MSG("  %u decodes, %u records: per decode %llu ticks, counters %.1f%%, flips %.1f%%, "
+        "syndrome updates %.1f%%\n", NUM_OF_TRACE_TESTS, sums.records,
+        (unsigned long long)(sums.t_total / NUM_OF_TRACE_TESTS),
+        100.0 * sums.t_counters / sums.t_total, 100.0 * sums.t_flip / sums.t_total,
+        100.0 * sums.t_syndrome / sums.t_total);
+    MSG("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
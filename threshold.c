@@ -140,3 +140,83 @@ size_t compute_threshold(size_t r, size_t n, size_t d, size_t w, size_t S,
 
     return threshold;
 }
+
+void threshold_table_init(threshold_table_t *tab, size_t r, size_t n,
+                          size_t d, size_t w, size_t t_max,
+                          double *lnbino_d, double *iks_t) {
+    tab->r = r;
+    tab->n = n;
+    tab->d = d;
+    tab->w = w;
+    tab->t_max = t_max;
+    tab->lnbino_d = lnbino_d;
+    tab->iks_t = iks_t;
+
+    for (size_t k = 0; k <= d; k++)
+        lnbino_d[k] = lnbino(d, k);
+    iks_t[0] = 0.;
+    for (size_t t = 1; t <= t_max; t++)
+        iks_t[t] = iks(r, n, w, t);
+}
+
+/* lnbinomialpmf(d, k, p, 1 - p) with ln C(d, k), ln p and ln(1 - p) given */
+static double lnbinomialpmf_tab(double lnbino_dk, size_t d, size_t k,
+                                double ln_p, double ln_1p) {
+    const double a = (k == 0) ? 0. : (double)k * ln_p;
+    const double b = (d - k == 0) ? 0. : (double)(d - k) * ln_1p;
+    return lnbino_dk + a + b;
+}
+
+size_t threshold_table_compute(const threshold_table_t *tab, size_t S,
+                               size_t t) {
+    const size_t n = tab->n;
+    const size_t d = tab->d;
+    const size_t w = tab->w;
+    double p, q;
+
+    double x = tab->iks_t[t] * S;
+    p = counters_C0(n, d, w, S, t, x);
+    q = counters_C1(n, d, w, S, t, x);
+
+    if (p >= 1.0 || p > q)
+        return d;
+
+    const double ln_p = log(p);
+    const double ln_1p = log(1. - p);
+    size_t threshold = d + 1;
+    double diff = 0.;
+    if (q >= 1.) {
+        do {
+            threshold--;
+            diff = -exp(lnbinomialpmf_tab(tab->lnbino_d[threshold], d,
+                                          threshold, ln_p, ln_1p)) *
+                       (n - t) +
+                   1.;
+        } while (diff >= 0. && threshold > (d + 1) / 2);
+    }
+    else {
+        const double ln_q = log(q);
+        const double ln_1q = log(1. - q);
+        do {
+            threshold--;
+            diff = (-exp(lnbinomialpmf_tab(tab->lnbino_d[threshold], d,
+                                           threshold, ln_p, ln_1p)) *
+                        (n - t) +
+                    exp(lnbinomialpmf_tab(tab->lnbino_d[threshold], d,
+                                          threshold, ln_q, ln_1q)) *
+                        t);
+        } while (diff >= 0. && threshold > (d + 1) / 2);
+    }
+
+    return threshold < d ? (threshold + 1) : d;
+}
+
+uint32_t threshold_lookup(const threshold_run_t *runs, uint32_t count,
+                          uint32_t weight) {
+    uint32_t threshold = runs[0].threshold;
+    for (uint32_t i = 1; i < count; i++) {
+        const uint32_t mask = 0 - (uint32_t)(weight >= runs[i].weight);
+        threshold = (runs[i].threshold & mask) | (threshold & ~mask);
+    }
+    return threshold;
+}
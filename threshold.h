@@ -38,6 +38,36 @@
 #ifndef THRESHOLD_H
 #define THRESHOLD_H
 #include <stddef.h>
+#include <stdint.h>
 size_t compute_threshold(size_t r, size_t n, size_t d, size_t w, size_t S,
                          size_t t);
+
+/* A threshold rule as a step function of the syndrome weight: run i gives
+ * the threshold for weights from runs[i].weight up to the next run. The
+ * tables of threshold_tables.h are generated by tools/gen_threshold_tables.c. */
+typedef struct threshold_run_s {
+    uint32_t weight;
+    uint32_t threshold;
+} threshold_run_t;
+
+/* Integer-only lookup; scans every run without branching on the weight. */
+uint32_t threshold_lookup(const threshold_run_t *runs, uint32_t count,
+                          uint32_t weight);
+
+/* compute_threshold(r, n, d, w, S, t) for fixed (r, n, d, w) and any
+ * t <= t_max, with the lgamma terms read from tables: ln C(d, k) for
+ * k = 0..d and the iks term for every t. The caller provides the storage
+ * (d + 1 and t_max + 1 doubles); threshold_table_init fills it once. The
+ * result equals compute_threshold bit for bit. */
+typedef struct threshold_table_s {
+    size_t r, n, d, w, t_max;
+    double *lnbino_d;
+    double *iks_t;
+} threshold_table_t;
+
+void threshold_table_init(threshold_table_t *tab, size_t r, size_t n,
+                          size_t d, size_t w, size_t t_max,
+                          double *lnbino_d, double *iks_t);
+size_t threshold_table_compute(const threshold_table_t *tab, size_t S,
+                               size_t t);
 #endif
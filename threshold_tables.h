@@ -0,0 +1,115 @@
+// Generated by tools/gen_threshold_tables.c (make threshold-tables).
+// {first syndrome weight, threshold} runs of the BGF threshold rules.
+
+#ifndef _THRESHOLD_TABLES_H_
+#define _THRESHOLD_TABLES_H_
+
+#include "types.h"
+#include "threshold.h"
+
+// r = 12323, d = 71, t = 134
+#if defined(PARAM64)
+static const threshold_run_t threshold_affine_runs[] = {
+    {0, 36}, {3367, 37}, {3510, 38}, {3654, 39}, {3797, 40}, {3940, 41},
+    {4084, 42}, {4227, 43}, {4371, 44}, {4514, 45}, {4658, 46}, {4801, 47},
+    {4944, 48}, {5088, 49}, {5231, 50}, {5375, 51}, {5518, 52}, {5662, 53},
+    {5805, 54}, {5948, 55}, {6092, 56}, {6235, 57}, {6379, 58}, {6522, 59},
+    {6666, 60}, {6809, 61}, {6952, 62}, {7096, 63}, {7239, 64}, {7383, 65},
+    {7526, 66}, {7670, 67}, {7813, 68}, {7956, 69}, {8100, 70}, {8243, 71},
+    {8387, 72}, {8530, 73}, {8674, 74}, {8817, 75}, {8960, 76}, {9104, 77},
+    {9247, 78}, {9391, 79}, {9534, 80}, {9678, 81}, {9821, 82}, {9964, 83},
+    {10108, 84}, {10251, 85}, {10395, 86}, {10538, 87}, {10681, 88}, {10825, 89},
+    {10968, 90}, {11112, 91}, {11255, 92}, {11399, 93}, {11542, 94}, {11685, 95},
+    {11829, 96}, {11972, 97}, {12116, 98}, {12259, 99},
+};
+static const threshold_run_t threshold_exact_runs[] = {
+    {0, 37}, {4135, 38}, {4297, 39}, {4459, 40}, {4620, 41}, {4780, 42},
+    {4940, 43}, {5100, 44}, {5258, 45}, {5416, 46}, {5572, 47}, {5728, 48},
+    {5882, 49}, {6035, 50}, {6187, 51}, {6336, 52}, {6484, 53}, {6630, 54},
+    {6773, 55}, {6912, 56}, {7049, 57}, {7181, 58}, {7308, 59}, {7430, 60},
+    {7545, 61}, {7651, 62}, {7747, 63}, {7831, 64}, {7901, 65}, {7955, 66},
+    {7991, 67}, {8010, 68}, {8017, 69}, {8018, 62}, {8219, 63}, {8445, 64},
+    {8677, 65}, {8918, 66}, {9168, 67}, {9429, 68}, {9705, 69}, {10001, 70},
+    {10329, 71},
+};
+#endif
+
+// r = 24659, d = 103, t = 199
+#if defined(PARAM96)
+static const threshold_run_t threshold_affine_runs[] = {
+    {0, 52}, {7169, 53}, {7359, 54}, {7549, 55}, {7739, 56}, {7929, 57},
+    {8118, 58}, {8308, 59}, {8498, 60}, {8688, 61}, {8878, 62}, {9068, 63},
+    {9258, 64}, {9448, 65}, {9638, 66}, {9828, 67}, {10018, 68}, {10208, 69},
+    {10398, 70}, {10588, 71}, {10778, 72}, {10967, 73}, {11157, 74}, {11347, 75},
+    {11537, 76}, {11727, 77}, {11917, 78}, {12107, 79}, {12297, 80}, {12487, 81},
+    {12677, 82}, {12867, 83}, {13057, 84}, {13247, 85}, {13437, 86}, {13627, 87},
+    {13816, 88}, {14006, 89}, {14196, 90}, {14386, 91}, {14576, 92}, {14766, 93},
+    {14956, 94}, {15146, 95}, {15336, 96}, {15526, 97}, {15716, 98}, {15906, 99},
+    {16096, 100}, {16286, 101}, {16476, 102}, {16665, 103}, {16855, 104}, {17045, 105},
+    {17235, 106}, {17425, 107}, {17615, 108}, {17805, 109}, {17995, 110}, {18185, 111},
+    {18375, 112}, {18565, 113}, {18755, 114}, {18945, 115}, {19135, 116}, {19325, 117},
+    {19514, 118}, {19704, 119}, {19894, 120}, {20084, 121}, {20274, 122}, {20464, 123},
+    {20654, 124}, {20844, 125}, {21034, 126}, {21224, 127}, {21414, 128}, {21604, 129},
+    {21794, 130}, {21984, 131}, {22174, 132}, {22364, 133}, {22553, 134}, {22743, 135},
+    {22933, 136}, {23123, 137}, {23313, 138}, {23503, 139}, {23693, 140}, {23883, 141},
+    {24073, 142}, {24263, 143}, {24453, 144}, {24643, 145},
+};
+static const threshold_run_t threshold_exact_runs[] = {
+    {0, 53}, {8754, 54}, {8976, 55}, {9199, 56}, {9421, 57}, {9642, 58},
+    {9863, 59}, {10084, 60}, {10304, 61}, {10524, 62}, {10743, 63}, {10961, 64},
+    {11179, 65}, {11396, 66}, {11613, 67}, {11828, 68}, {12043, 69}, {12257, 70},
+    {12469, 71}, {12681, 72}, {12892, 73}, {13101, 74}, {13308, 75}, {13514, 76},
+    {13719, 77}, {13921, 78}, {14121, 79}, {14319, 80}, {14514, 81}, {14706, 82},
+    {14895, 83}, {15080, 84}, {15261, 85}, {15437, 86}, {15608, 87}, {15773, 88},
+    {15930, 89}, {16080, 90}, {16220, 91}, {16349, 92}, {16467, 93}, {16570, 94},
+    {16658, 95}, {16728, 96}, {16781, 97}, {16815, 98}, {16834, 99}, {16841, 100},
+    {16843, 89}, {17003, 90}, {17306, 91}, {17615, 92}, {17928, 93}, {18249, 94},
+    {18576, 95}, {18910, 96}, {19254, 97}, {19609, 98}, {19977, 99}, {20360, 100},
+    {20765, 101}, {21199, 102}, {21678, 103},
+};
+#endif
+
+// r = 40973, d = 137, t = 264
+#if defined(PARAM128)
+static const threshold_run_t threshold_affine_runs[] = {
+    {0, 69}, {12956, 70}, {13205, 71}, {13453, 72}, {13702, 73}, {13950, 74},
+    {14199, 75}, {14447, 76}, {14696, 77}, {14944, 78}, {15193, 79}, {15442, 80},
+    {15690, 81}, {15939, 82}, {16187, 83}, {16436, 84}, {16684, 85}, {16933, 86},
+    {17182, 87}, {17430, 88}, {17679, 89}, {17927, 90}, {18176, 91}, {18424, 92},
+    {18673, 93}, {18922, 94}, {19170, 95}, {19419, 96}, {19667, 97}, {19916, 98},
+    {20164, 99}, {20413, 100}, {20661, 101}, {20910, 102}, {21159, 103}, {21407, 104},
+    {21656, 105}, {21904, 106}, {22153, 107}, {22401, 108}, {22650, 109}, {22899, 110},
+    {23147, 111}, {23396, 112}, {23644, 113}, {23893, 114}, {24141, 115}, {24390, 116},
+    {24638, 117}, {24887, 118}, {25136, 119}, {25384, 120}, {25633, 121}, {25881, 122},
+    {26130, 123}, {26378, 124}, {26627, 125}, {26876, 126}, {27124, 127}, {27373, 128},
+    {27621, 129}, {27870, 130}, {28118, 131}, {28367, 132}, {28615, 133}, {28864, 134},
+    {29113, 135}, {29361, 136}, {29610, 137}, {29858, 138}, {30107, 139}, {30355, 140},
+    {30604, 141}, {30853, 142}, {31101, 143}, {31350, 144}, {31598, 145}, {31847, 146},
+    {32095, 147}, {32344, 148}, {32592, 149}, {32841, 150}, {33090, 151}, {33338, 152},
+    {33587, 153}, {33835, 154}, {34084, 155}, {34332, 156}, {34581, 157}, {34830, 158},
+    {35078, 159}, {35327, 160}, {35575, 161}, {35824, 162}, {36072, 163}, {36321, 164},
+    {36570, 165}, {36818, 166}, {37067, 167}, {37315, 168}, {37564, 169}, {37812, 170},
+    {38061, 171}, {38309, 172}, {38558, 173}, {38807, 174}, {39055, 175}, {39304, 176},
+    {39552, 177}, {39801, 178}, {40049, 179}, {40298, 180}, {40547, 181}, {40795, 182},
+};
+static const threshold_run_t threshold_exact_runs[] = {
+    {0, 70}, {15116, 71}, {15395, 72}, {15674, 73}, {15952, 74}, {16231, 75},
+    {16508, 76}, {16786, 77}, {17063, 78}, {17340, 79}, {17617, 80}, {17893, 81},
+    {18169, 82}, {18444, 83}, {18719, 84}, {18993, 85}, {19267, 86}, {19540, 87},
+    {19812, 88}, {20084, 89}, {20356, 90}, {20626, 91}, {20896, 92}, {21165, 93},
+    {21434, 94}, {21701, 95}, {21967, 96}, {22233, 97}, {22497, 98}, {22760, 99},
+    {23022, 100}, {23283, 101}, {23542, 102}, {23800, 103}, {24056, 104}, {24310, 105},
+    {24562, 106}, {24812, 107}, {25059, 108}, {25305, 109}, {25547, 110}, {25786, 111},
+    {26022, 112}, {26254, 113}, {26483, 114}, {26706, 115}, {26925, 116}, {27138, 117},
+    {27346, 118}, {27546, 119}, {27738, 120}, {27922, 121}, {28097, 122}, {28261, 123},
+    {28413, 124}, {28551, 125}, {28675, 126}, {28782, 127}, {28872, 128}, {28943, 129},
+    {28996, 130}, {29032, 131}, {29052, 132}, {29060, 133}, {29063, 119}, {29418, 120},
+    {29796, 121}, {30177, 122}, {30564, 123}, {30955, 124}, {31353, 125}, {31757, 126},
+    {32167, 127}, {32585, 128}, {33012, 129}, {33449, 130}, {33897, 131}, {34358, 132},
+    {34836, 133}, {35335, 134}, {35860, 135}, {36422, 136}, {37042, 137},
+};
+#endif
+
+#define THRESHOLD_RUNS(t) ((uint32_t)(sizeof(t) / sizeof(t[0])))
+
+#endif //_THRESHOLD_TABLES_H_
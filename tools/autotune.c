@@ -0,0 +1,412 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// Decoder autotuner: runs BGF_decoder_cfg_ws over a grid of iteration
+// counts, gray gaps (tau), threshold rules and offsets and masked-iteration
+// thresholds. For every point it measures the time per decode and the
+// failure rate on the same trials (batch b of every point uses the same
+// key and errors). Then it marks the Pareto frontier of (time, DFR) and
+// writes all points as CSV or JSON. Lists are comma separated.
+//   bike-autotune [-n trials per point] [-w weight] [-b trials per key]
+//                 [-s seed] [-t threads] [-I iterations] [-g gaps]
+//                 [-r affine,exact] [-o offsets] [-m masked thresholds]
+//                 [-f csv|json] [-O file]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <chrono>
+
+#include "workspace.h"
+#include "dfr_trial.h"
+
+#ifdef BIKE_LOW_MEM
+#error "bike-autotune runs the byte-per-bit BGF decoder (not in BIKE_LOW_MEM)"
+#endif
+
+#define TUNE_DEFAULT_TRIALS 4096ULL
+#define TUNE_DEFAULT_BATCH 256U
+#define TUNE_MAX_THREADS 256U
+#define TUNE_MAX_VALUES 16U
+
+typedef struct tune_point_s
+{
+    bgf_config_t cfg;
+    uint64_t trials;
+    uint64_t failures;
+    uint64_t decode_ns;
+    int pareto;
+} tune_point_t;
+
+typedef struct tune_run_s
+{
+    uint64_t seed;
+    uint32_t weight;
+    uint32_t batch;
+    uint64_t n_batches;
+    uint64_t claim;
+    uint32_t failed_threads;
+    tune_point_t* point;
+} tune_run_t;
+
+typedef struct tune_list_s
+{
+    int32_t v[TUNE_MAX_VALUES];
+    uint32_t n;
+} tune_list_t;
+
+static void* tune_worker(IN void* arg)
+{
+    tune_run_t* run = (tune_run_t*)arg;
+    dfr_trial_t* t = (dfr_trial_t*)malloc(sizeof(dfr_trial_t));
+    bike_ws_t* ws = bike_ws_alloc();
+    uint64_t b;
+
+    if ((t == NULL) || (ws == NULL))
+    {
+        __atomic_fetch_add(&run->failed_threads, 1, __ATOMIC_RELAXED);
+        run = NULL;
+    }
+
+    while ((run != NULL) && ((b = __atomic_fetch_add(&run->claim, 1, __ATOMIC_RELAXED)) < run->n_batches))
+    {
+        shake256_prng_state_t prng;
+        uint64_t failures = 0;
+        uint64_t ns = 0;
+
+        dfr_batch_prng(&prng, run->seed, b);
+        dfr_sample_key(t, &prng);
+
+        for (uint32_t k = 0; k < run->batch; k++)
+        {
+            dfr_sample_error(t, run->weight, &prng);
+
+            const auto start = std::chrono::steady_clock::now();
+            const int rc = BGF_decoder_cfg_ws(t->e, t->s, t->h0, t->h1, &run->point->cfg, NULL, ws);
+            const auto end = std::chrono::steady_clock::now();
+
+            ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            failures += (rc != 0) || (memcmp(t->e, t->e_true, 2*R_BITS) != 0);
+        }
+
+        __atomic_fetch_add(&run->point->trials, run->batch, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&run->point->failures, failures, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&run->point->decode_ns, ns, __ATOMIC_RELAXED);
+    }
+
+    bike_ws_free(ws);
+    free(t);
+    return NULL;
+}
+
+static int run_point(IN OUT tune_run_t* run, IN const uint32_t n_threads)
+{
+    pthread_t threads[TUNE_MAX_THREADS];
+    uint32_t started = 0;
+
+    run->claim = 0;
+    run->failed_threads = 0;
+    for (; started < n_threads; started++)
+    {
+        if (pthread_create(&threads[started], NULL, tune_worker, run) != 0)
+        {
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    return (started > 0) && (run->failed_threads < started);
+}
+
+static double point_dfr(IN const tune_point_t* p)
+{
+    return (double)p->failures / p->trials;
+}
+
+static double point_us(IN const tune_point_t* p)
+{
+    return p->decode_ns / 1000.0 / p->trials;
+}
+
+// A point is on the frontier unless another one is as fast and as reliable,
+// and strictly better in one of the two.
+static void mark_pareto(IN OUT tune_point_t* p, IN const uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        p[i].pareto = 1;
+        for (uint32_t j = 0; (j < n) && p[i].pareto; j++)
+        {
+            const double dt = point_us(&p[j]) - point_us(&p[i]);
+            const double df = point_dfr(&p[j]) - point_dfr(&p[i]);
+            if ((dt <= 0) && (df <= 0) && ((dt < 0) || (df < 0)))
+            {
+                p[i].pareto = 0;
+            }
+        }
+    }
+}
+
+static const char* rule_name(IN const uint32_t rule)
+{
+    return (rule == THRESHOLD_EXACT) ? "exact" : "affine";
+}
+
+static void write_csv(IN FILE* f, IN const tune_point_t* p, IN const uint32_t n, IN const uint32_t weight)
+{
+    fprintf(f, "r,dv,weight,n_iter,tau,rule,threshold_offset,masked_threshold,"
+            "trials,failures,dfr,dfr_lo,dfr_hi,us_per_decode,pareto\n");
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double lo, hi;
+        dfr_wilson(p[i].failures, p[i].trials, &lo, &hi);
+        fprintf(f, "%u,%u,%u,%u,%u,%s,%d,%u,%llu,%llu,%.6e,%.6e,%.6e,%.2f,%d\n",
+                (uint32_t)R_BITS, (uint32_t)DV, weight, p[i].cfg.n_iter, p[i].cfg.gray_gap,
+                rule_name(p[i].cfg.rule), p[i].cfg.threshold_offset, p[i].cfg.masked_threshold,
+                (unsigned long long)p[i].trials, (unsigned long long)p[i].failures,
+                point_dfr(&p[i]), lo, hi, point_us(&p[i]), p[i].pareto);
+    }
+}
+
+static void write_json(IN FILE* f, IN const tune_point_t* p, IN const uint32_t n, IN const uint32_t weight)
+{
+    fprintf(f, "{\n  \"r\": %u,\n  \"dv\": %u,\n  \"weight\": %u,\n  \"points\": [\n",
+            (uint32_t)R_BITS, (uint32_t)DV, weight);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double lo, hi;
+        dfr_wilson(p[i].failures, p[i].trials, &lo, &hi);
+        fprintf(f, "    {\"n_iter\": %u, \"tau\": %u, \"rule\": \"%s\", \"threshold_offset\": %d, "
+                "\"masked_threshold\": %u, \"trials\": %llu, \"failures\": %llu, \"dfr\": %.6e, "
+                "\"dfr_lo\": %.6e, \"dfr_hi\": %.6e, \"us_per_decode\": %.2f, \"pareto\": %s}%s\n",
+                p[i].cfg.n_iter, p[i].cfg.gray_gap, rule_name(p[i].cfg.rule),
+                p[i].cfg.threshold_offset, p[i].cfg.masked_threshold,
+                (unsigned long long)p[i].trials, (unsigned long long)p[i].failures,
+                point_dfr(&p[i]), lo, hi, point_us(&p[i]), p[i].pareto ? "true" : "false",
+                (i + 1 < n) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+// Parses a comma-separated list; rules are given by name.
+static int parse_list(OUT tune_list_t* l, IN const char* arg, IN const int rules)
+{
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", arg);
+
+    l->n = 0;
+    for (char* tok = strtok(buf, ","); tok != NULL; tok = strtok(NULL, ","))
+    {
+        if (l->n == TUNE_MAX_VALUES)
+        {
+            return 0;
+        }
+        if (rules)
+        {
+            if (strcmp(tok, "affine") == 0)
+            {
+                l->v[l->n++] = THRESHOLD_AFFINE;
+            }
+            else if (strcmp(tok, "exact") == 0)
+            {
+                l->v[l->n++] = THRESHOLD_EXACT;
+            }
+            else
+            {
+                return 0;
+            }
+        }
+        else
+        {
+            l->v[l->n++] = atoi(tok);
+        }
+    }
+
+    return (l->n > 0);
+}
+
+int main(int argc, char **argv)
+{
+    tune_run_t run;
+    tune_list_t iters, gaps, rules, offsets, masked;
+    uint64_t trials = TUNE_DEFAULT_TRIALS;
+    const char* format = "csv";
+    const char* path = NULL;
+    const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t n_threads = (ncpu > 0) ? (uint32_t)ncpu : 1;
+    char masked_default[64];
+    int ok = 1;
+    int opt;
+
+    memset(&run, 0, sizeof(run));
+    run.seed = 1;
+    run.weight = T1;
+    run.batch = TUNE_DEFAULT_BATCH;
+    snprintf(masked_default, sizeof(masked_default), "%u,%u,%u",
+            (uint32_t)(DV+1)/2, (uint32_t)(DV+1)/2 + 1, (uint32_t)(DV+1)/2 + 2);
+    parse_list(&iters, "3,4,5,6", 0);
+    parse_list(&gaps, "2,3,4", 0);
+    parse_list(&rules, "affine,exact", 1);
+    parse_list(&offsets, "0", 0);
+    parse_list(&masked, masked_default, 0);
+
+    while ((opt = getopt(argc, argv, "n:w:b:s:t:I:g:r:o:m:f:O:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': trials = strtoull(optarg, NULL, 0); break;
+        case 'w': run.weight = (uint32_t)atoi(optarg); break;
+        case 'b': run.batch = (uint32_t)atoi(optarg); break;
+        case 's': run.seed = strtoull(optarg, NULL, 0); break;
+        case 't': n_threads = (uint32_t)atoi(optarg); break;
+        case 'I': ok &= parse_list(&iters, optarg, 0); break;
+        case 'g': ok &= parse_list(&gaps, optarg, 0); break;
+        case 'r': ok &= parse_list(&rules, optarg, 1); break;
+        case 'o': ok &= parse_list(&offsets, optarg, 0); break;
+        case 'm': ok &= parse_list(&masked, optarg, 0); break;
+        case 'f': format = optarg; break;
+        case 'O': path = optarg; break;
+        default: ok = 0; break;
+        }
+    }
+
+    const int json = (strcmp(format, "json") == 0);
+    for (uint32_t i = 0; i < iters.n; i++)
+    {
+        ok &= (iters.v[i] >= 1) && (iters.v[i] <= (int32_t)BGF_MAX_ITER);
+    }
+    for (uint32_t i = 0; i < gaps.n; i++)
+    {
+        ok &= (gaps.v[i] >= 0);
+    }
+    for (uint32_t i = 0; i < masked.n; i++)
+    {
+        ok &= (masked.v[i] >= 1);
+    }
+    if (!ok || (run.weight == 0) || (run.weight >= N_BITS) || (run.batch == 0) || (trials == 0) ||
+        (n_threads == 0) || (n_threads > TUNE_MAX_THREADS) || (!json && strcmp(format, "csv")))
+    {
+        MSG("usage: %s [-n trials per point] [-w weight] [-b trials per key] [-s seed] [-t threads]\n"
+            "       [-I iterations] [-g gaps] [-r affine,exact] [-o offsets] [-m masked thresholds]\n"
+            "       [-f csv|json] [-O file]\n", argv[0]);
+        return 1;
+    }
+    if (path == NULL)
+    {
+        path = json ? "bike-autotune.json" : "bike-autotune.csv";
+    }
+
+    const uint32_t n_points = iters.n * gaps.n * rules.n * offsets.n * masked.n;
+    tune_point_t* points = (tune_point_t*)calloc(n_points, sizeof(tune_point_t));
+    if (points == NULL)
+    {
+        MSG("allocation failed\n");
+        return 1;
+    }
+    run.n_batches = (trials + run.batch - 1) / run.batch;
+
+    MSG("BIKE decoder autotune, r: %d, dv: %d, error weight: %u, %llu trials per point, "
+        "%u points, %u threads\n", (int)R_BITS, (int)DV, run.weight,
+        (unsigned long long)(run.n_batches * run.batch), n_points, n_threads);
+
+    uint32_t n = 0;
+    for (uint32_t a = 0; a < iters.n; a++)
+    for (uint32_t g = 0; g < gaps.n; g++)
+    for (uint32_t r = 0; r < rules.n; r++)
+    for (uint32_t o = 0; o < offsets.n; o++)
+    for (uint32_t m = 0; m < masked.n; m++, n++)
+    {
+        tune_point_t* p = &points[n];
+        p->cfg.n_iter = (uint32_t)iters.v[a];
+        p->cfg.gray_gap = (uint32_t)gaps.v[g];
+        p->cfg.rule = (uint32_t)rules.v[r];
+        p->cfg.threshold_offset = offsets.v[o];
+        p->cfg.masked_threshold = (uint32_t)masked.v[m];
+
+        run.point = p;
+        if (!run_point(&run, n_threads))
+        {
+            MSG("cannot start the worker threads\n");
+            free(points);
+            return 1;
+        }
+        MSG("  n_iter %2u  tau %u  %-6s %+d  masked %3u: %8.1f us, %llu/%llu failures\n",
+            p->cfg.n_iter, p->cfg.gray_gap, rule_name(p->cfg.rule), p->cfg.threshold_offset,
+            p->cfg.masked_threshold, point_us(p), (unsigned long long)p->failures,
+            (unsigned long long)p->trials);
+    }
+
+    mark_pareto(points, n_points);
+
+    FILE* f = fopen(path, "w");
+    if (f == NULL)
+    {
+        MSG("cannot write %s\n", path);
+        free(points);
+        return 1;
+    }
+    if (json)
+    {
+        write_json(f, points, n_points, run.weight);
+    }
+    else
+    {
+        write_csv(f, points, n_points, run.weight);
+    }
+    fclose(f);
+
+    MSG("Pareto frontier (written with all points to %s):\n", path);
+    for (uint32_t i = 0; i < n_points; i++)
+    {
+        if (points[i].pareto)
+        {
+            MSG("  n_iter %2u  tau %u  %-6s %+d  masked %3u: %8.1f us, DFR %.3e\n",
+                points[i].cfg.n_iter, points[i].cfg.gray_gap, rule_name(points[i].cfg.rule),
+                points[i].cfg.threshold_offset, points[i].cfg.masked_threshold,
+                point_us(&points[i]), point_dfr(&points[i]));
+        }
+    }
+
+    free(points);
+    return 0;
+}
@@ -0,0 +1,739 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// Statistical benchmark of the KEM API. For every level and operation
+// (keygen, encaps, decaps) it runs the calls for a warmup time, then
+// records the latency of every call for the given duration in a log-linear
+// (HDR-style) histogram. It reports p50/p90/p99/p99.9, the throughput and
+// 95% confidence intervals of the mean latency (from the means of batches
+// of BENCH_BATCH calls) and of p99 (from the binomial spread of its rank),
+// on the screen and as CSV or JSON with -O. With -m it also records the
+// peak stack, heap and allocation count of every operation
+// (mem_profile.h). -c compares two such files and flags the operations
+// that got slower or bigger beyond the noise; the exit status is 1 if any
+// did. -D backflip times decaps with the Backflip decoder instead of the
+// build's DECODER (op "decaps-bf").
+//   bike-bench [-l levels] [-d seconds] [-w warmup seconds] [-m] [-D bgf|backflip]
+//              [-f csv|json] [-O file]
+//   bike-bench -c base new [-T threshold %]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <unistd.h>
+#include <chrono>
+
+#include "levels/bike_kem.h"
+#include "mem_profile.h"
+
+#define BENCH_DEFAULT_SECONDS 2.0
+#define BENCH_DEFAULT_WARMUP 0.5
+#define BENCH_DEFAULT_THRESHOLD 5.0
+#define BENCH_BATCH 32U
+#define BENCH_POOL 8U
+#define BENCH_MAX_RESULTS 16U
+#define BENCH_Z 1.96
+#define BENCH_MEM_RUNS 3U
+
+// Histogram of latencies in ns: exact below 2^HIST_SUB_BITS, then
+// HIST_HALF linear buckets per power of two (at most 1/64 relative error).
+#define HIST_SUB_BITS 7U
+#define HIST_HALF (1U << (HIST_SUB_BITS - 1U))
+#define HIST_BUCKETS ((64U - HIST_SUB_BITS + 2U) * HIST_HALF)
+
+typedef struct hist_s
+{
+    uint64_t count[HIST_BUCKETS];
+    uint64_t n;
+    uint64_t min;
+    uint64_t max;
+} hist_t;
+
+typedef enum
+{
+    OP_KEYGEN = 0,
+    OP_ENCAPS,
+    OP_DECAPS,
+    OP_COUNT
+} bench_op_t;
+
+static const char* const op_names[OP_COUNT] = {"keygen", "encaps", "decaps"};
+
+// One line of the output; everything but level and op is a number.
+typedef struct bench_result_s
+{
+    uint32_t level;
+    char op[16];
+    double calls;
+    double seconds;
+    double ops_per_s;
+    double mean_ns;
+    double ci95_ns;
+    double min_ns;
+    double p50_ns;
+    double p90_ns;
+    double p99_ns;
+    double p99_lo_ns;
+    double p99_hi_ns;
+    double p999_ns;
+    double max_ns;
+    double stack_bytes;
+    double heap_bytes;
+    double allocs;
+} bench_result_t;
+
+static const struct
+{
+    const char* name;
+    size_t offset;
+    int precision;
+} bench_fields[] = {
+    {"calls",     offsetof(bench_result_t, calls),     0},
+    {"seconds",   offsetof(bench_result_t, seconds),   3},
+    {"ops_per_s", offsetof(bench_result_t, ops_per_s), 1},
+    {"mean_ns",   offsetof(bench_result_t, mean_ns),   1},
+    {"ci95_ns",   offsetof(bench_result_t, ci95_ns),   1},
+    {"min_ns",    offsetof(bench_result_t, min_ns),    0},
+    {"p50_ns",    offsetof(bench_result_t, p50_ns),    0},
+    {"p90_ns",    offsetof(bench_result_t, p90_ns),    0},
+    {"p99_ns",    offsetof(bench_result_t, p99_ns),    0},
+    {"p99_lo_ns", offsetof(bench_result_t, p99_lo_ns), 0},
+    {"p99_hi_ns", offsetof(bench_result_t, p99_hi_ns), 0},
+    {"p999_ns",   offsetof(bench_result_t, p999_ns),   0},
+    {"max_ns",    offsetof(bench_result_t, max_ns),    0},
+    {"stack_bytes", offsetof(bench_result_t, stack_bytes), 0},
+    {"heap_bytes",  offsetof(bench_result_t, heap_bytes),  0},
+    {"allocs",      offsetof(bench_result_t, allocs),      0},
+};
+#define BENCH_N_FIELDS (sizeof(bench_fields)/sizeof(bench_fields[0]))
+
+static double* field(bench_result_t* r, const uint32_t i)
+{
+    return (double*)((char*)r + bench_fields[i].offset);
+}
+
+////////////////////////////////////////////////////////////////
+//   Histogram
+////////////////////////////////////////////////////////////////
+
+static uint32_t hist_index(const uint64_t v)
+{
+    if (v < (1ULL << HIST_SUB_BITS))
+    {
+        return (uint32_t)v;
+    }
+    const uint32_t shift = (63U - (uint32_t)__builtin_clzll(v)) - HIST_SUB_BITS + 1U;
+    return (shift + 1U) * HIST_HALF + (uint32_t)((v >> shift) - HIST_HALF);
+}
+
+// The largest value of bucket i.
+static uint64_t hist_value(const uint32_t i)
+{
+    if (i < 2U * HIST_HALF)
+    {
+        return i;
+    }
+    const uint32_t shift = i / HIST_HALF - 1U;
+    return (((uint64_t)HIST_HALF + i % HIST_HALF + 1U) << shift) - 1U;
+}
+
+static void hist_add(hist_t* h, const uint64_t v)
+{
+    h->count[hist_index(v)]++;
+    h->min = (h->n == 0 || v < h->min) ? v : h->min;
+    h->max = (v > h->max) ? v : h->max;
+    h->n++;
+}
+
+// The value of the given rank (1..n), within the bucket precision.
+static uint64_t hist_rank(const hist_t* h, double rank)
+{
+    uint64_t seen = 0;
+    rank = (rank < 1) ? 1 : ((rank > (double)h->n) ? (double)h->n : rank);
+
+    for (uint32_t i = 0; i < HIST_BUCKETS; i++)
+    {
+        seen += h->count[i];
+        if ((double)seen >= rank)
+        {
+            const uint64_t v = hist_value(i);
+            return (v < h->min) ? h->min : ((v > h->max) ? h->max : v);
+        }
+    }
+    return h->max;
+}
+
+static uint64_t hist_quantile(const hist_t* h, const double q)
+{
+    return hist_rank(h, ceil(q * (double)h->n));
+}
+
+// The 95% interval of quantile q: the rank of the q-quantile of n samples
+// spreads like a binomial(n, q) count.
+static void hist_quantile_ci(const hist_t* h, const double q, double* lo, double* hi)
+{
+    const double spread = BENCH_Z * sqrt((double)h->n * q * (1.0 - q));
+    *lo = (double)hist_rank(h, floor(q * (double)h->n - spread));
+    *hi = (double)hist_rank(h, ceil(q * (double)h->n + spread) + 1);
+}
+
+////////////////////////////////////////////////////////////////
+//   Measurement
+////////////////////////////////////////////////////////////////
+
+typedef struct bench_kem_s
+{
+    const bike_kem_t* kem;
+    int (*dec)(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
+    unsigned char* pk[BENCH_POOL];
+    unsigned char* sk[BENCH_POOL];
+    unsigned char* ct[BENCH_POOL];
+    unsigned char* ss;
+    unsigned char* pk_out;
+    unsigned char* sk_out;
+    unsigned char* ct_out;
+} bench_kem_t;
+
+static void bench_kem_free(bench_kem_t* b)
+{
+    for (uint32_t i = 0; i < BENCH_POOL; i++)
+    {
+        free(b->pk[i]);
+        free(b->sk[i]);
+        free(b->ct[i]);
+    }
+    free(b->ss);
+    free(b->pk_out);
+    free(b->sk_out);
+    free(b->ct_out);
+}
+
+// Keys and ciphertexts that encaps and decaps cycle through.
+static int bench_kem_init(bench_kem_t* b, const bike_kem_t* kem, const int backflip)
+{
+    int ok = 1;
+
+    memset(b, 0, sizeof(*b));
+    b->kem = kem;
+    b->dec = backflip ? kem->dec_backflip : kem->dec;
+    ok &= (b->dec != NULL);
+    for (uint32_t i = 0; i < BENCH_POOL; i++)
+    {
+        b->pk[i] = (unsigned char*)malloc(kem->pk_bytes);
+        b->sk[i] = (unsigned char*)malloc(kem->sk_bytes);
+        b->ct[i] = (unsigned char*)malloc(kem->ct_bytes);
+        ok &= (b->pk[i] != NULL) && (b->sk[i] != NULL) && (b->ct[i] != NULL);
+    }
+    b->ss = (unsigned char*)malloc(kem->ss_bytes);
+    b->pk_out = (unsigned char*)malloc(kem->pk_bytes);
+    b->sk_out = (unsigned char*)malloc(kem->sk_bytes);
+    b->ct_out = (unsigned char*)malloc(kem->ct_bytes);
+    ok &= (b->ss != NULL) && (b->pk_out != NULL) && (b->sk_out != NULL) && (b->ct_out != NULL);
+
+    for (uint32_t i = 0; ok && (i < BENCH_POOL); i++)
+    {
+        ok &= (kem->keypair(b->pk[i], b->sk[i]) == 0) && (kem->enc(b->ct[i], b->ss, b->pk[i]) == 0);
+    }
+    if (!ok)
+    {
+        bench_kem_free(b);
+    }
+    return ok;
+}
+
+static int bench_call(bench_kem_t* b, const bench_op_t op, const uint32_t i)
+{
+    const uint32_t k = i % BENCH_POOL;
+    switch (op)
+    {
+    case OP_KEYGEN: return b->kem->keypair(b->pk_out, b->sk_out);
+    case OP_ENCAPS: return b->kem->enc(b->ct_out, b->ss, b->pk[k]);
+    default:        return b->dec(b->ss, b->ct[k], b->sk[k]);
+    }
+}
+
+// Warms up, then times every call for the given seconds.
+static int bench_op(bench_result_t* r, hist_t* h, bench_kem_t* b, const bench_op_t op,
+        const double seconds, const double warmup)
+{
+    typedef std::chrono::steady_clock clk;
+    uint32_t n_batches = 0;
+    uint32_t cap = 1024;
+    double* batch_ns = (double*)malloc(cap * sizeof(double));
+    double batch_sum = 0;
+    int rc = 0;
+
+    if (batch_ns == NULL)
+    {
+        return 1;
+    }
+    memset(h, 0, sizeof(*h));
+
+    const clk::time_point w0 = clk::now();
+    for (uint32_t i = 0; std::chrono::duration<double>(clk::now() - w0).count() < warmup; i++)
+    {
+        rc |= bench_call(b, op, i);
+    }
+
+    const clk::time_point t0 = clk::now();
+    clk::time_point t = t0;
+    for (uint32_t i = 0; (std::chrono::duration<double>(t - t0).count() < seconds) ||
+            (n_batches < 2); i++)
+    {
+        rc |= bench_call(b, op, i);
+        const clk::time_point t1 = clk::now();
+        const uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t).count();
+        t = t1;
+
+        hist_add(h, ns);
+        batch_sum += (double)ns;
+        if ((h->n % BENCH_BATCH) == 0)
+        {
+            if (n_batches == cap)
+            {
+                double* p = (double*)realloc(batch_ns, 2 * cap * sizeof(double));
+                if (p == NULL)
+                {
+                    free(batch_ns);
+                    return 1;
+                }
+                batch_ns = p;
+                cap *= 2;
+            }
+            batch_ns[n_batches++] = batch_sum / BENCH_BATCH;
+            batch_sum = 0;
+        }
+    }
+
+    // The mean of all calls; its CI from the spread of the batch means.
+    double mean = 0, var = 0;
+    for (uint32_t i = 0; i < n_batches; i++)
+    {
+        mean += batch_ns[i];
+    }
+    mean /= n_batches;
+    for (uint32_t i = 0; i < n_batches; i++)
+    {
+        var += (batch_ns[i] - mean) * (batch_ns[i] - mean);
+    }
+    var /= (n_batches - 1);
+    free(batch_ns);
+
+    const double elapsed = std::chrono::duration<double>(t - t0).count();
+    r->calls = (double)h->n;
+    r->seconds = elapsed;
+    r->ops_per_s = (double)h->n / elapsed;
+    r->mean_ns = elapsed * 1e9 / (double)h->n;
+    r->ci95_ns = BENCH_Z * sqrt(var / n_batches);
+    r->min_ns = (double)h->min;
+    r->p50_ns = (double)hist_quantile(h, 0.5);
+    r->p90_ns = (double)hist_quantile(h, 0.9);
+    r->p99_ns = (double)hist_quantile(h, 0.99);
+    hist_quantile_ci(h, 0.99, &r->p99_lo_ns, &r->p99_hi_ns);
+    r->p999_ns = (double)hist_quantile(h, 0.999);
+    r->max_ns = (double)h->max;
+
+    return rc;
+}
+
+typedef struct bench_mem_call_s
+{
+    bench_kem_t* b;
+    int op;                     // -1: an empty thread
+} bench_mem_call_t;
+
+static void* bench_mem_call(void* arg)
+{
+    bench_mem_call_t* m = (bench_mem_call_t*)arg;
+    return (void*)(intptr_t)((m->op < 0) ? 0 : bench_call(m->b, (bench_op_t)m->op, 0));
+}
+
+// Peak memory of BENCH_MEM_RUNS calls, each on a fresh thread (so the
+// thread workspace of decaps is counted), less that of an empty thread.
+static int bench_mem(bench_result_t* r, bench_kem_t* b, const bench_op_t op)
+{
+    bench_mem_call_t empty_call = {b, -1};
+    bench_mem_call_t call = {b, (int)op};
+    mem_usage_t empty, usage, peak = {0, 0, 0};
+    int rc = 0;
+
+    mem_profile_run(bench_mem_call, &empty_call, &empty);
+    for (uint32_t i = 0; i < BENCH_MEM_RUNS; i++)
+    {
+        rc |= mem_profile_run(bench_mem_call, &call, &usage);
+        mem_usage_peak(&peak, usage, &empty);
+    }
+
+    r->stack_bytes = (double)peak.stack;
+    r->heap_bytes = (double)peak.heap;
+    r->allocs = (double)peak.allocs;
+    return rc;
+}
+
+////////////////////////////////////////////////////////////////
+//   Output and comparison
+////////////////////////////////////////////////////////////////
+
+static void write_csv(FILE* f, bench_result_t* r, const uint32_t n)
+{
+    fprintf(f, "level,op");
+    for (uint32_t j = 0; j < BENCH_N_FIELDS; j++)
+    {
+        fprintf(f, ",%s", bench_fields[j].name);
+    }
+    fprintf(f, "\n");
+    for (uint32_t i = 0; i < n; i++)
+    {
+        fprintf(f, "%u,%s", r[i].level, r[i].op);
+        for (uint32_t j = 0; j < BENCH_N_FIELDS; j++)
+        {
+            fprintf(f, ",%.*f", bench_fields[j].precision, *field(&r[i], j));
+        }
+        fprintf(f, "\n");
+    }
+}
+
+static void write_json(FILE* f, bench_result_t* r, const uint32_t n, const double seconds,
+        const double warmup)
+{
+    fprintf(f, "{\n  \"duration_s\": %.3f,\n  \"warmup_s\": %.3f,\n  \"results\": [\n",
+            seconds, warmup);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        fprintf(f, "    {\"level\": %u, \"op\": \"%s\"", r[i].level, r[i].op);
+        for (uint32_t j = 0; j < BENCH_N_FIELDS; j++)
+        {
+            fprintf(f, ", \"%s\": %.*f", bench_fields[j].name, bench_fields[j].precision,
+                    *field(&r[i], j));
+        }
+        fprintf(f, "}%s\n", (i + 1 < n) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+// A JSON result line: one object with "level", "op" and the fields.
+static int parse_json_line(bench_result_t* r, const char* line)
+{
+    const char* p = strstr(line, "\"op\": \"");
+    const char* q = strstr(line, "\"level\": ");
+    if ((p == NULL) || (q == NULL))
+    {
+        return 0;
+    }
+    memset(r, 0, sizeof(*r));
+    r->level = (uint32_t)atoi(q + strlen("\"level\": "));
+    sscanf(p + strlen("\"op\": \""), "%15[^\"]", r->op);
+
+    for (uint32_t j = 0; j < BENCH_N_FIELDS; j++)
+    {
+        char key[32];
+        snprintf(key, sizeof(key), "\"%s\": ", bench_fields[j].name);
+        const char* v = strstr(line, key);
+        if (v != NULL)
+        {
+            *field(r, j) = strtod(v + strlen(key), NULL);
+        }
+    }
+    return 1;
+}
+
+// A CSV row, its columns named by the header.
+static int parse_csv_line(bench_result_t* r, char* line, char header[][32], const uint32_t n_cols)
+{
+    uint32_t c = 0;
+
+    memset(r, 0, sizeof(*r));
+    for (char* tok = strtok(line, ",\n"); (tok != NULL) && (c < n_cols); tok = strtok(NULL, ",\n"), c++)
+    {
+        if (strcmp(header[c], "level") == 0)
+        {
+            r->level = (uint32_t)atoi(tok);
+        }
+        else if (strcmp(header[c], "op") == 0)
+        {
+            snprintf(r->op, sizeof(r->op), "%s", tok);
+        }
+        for (uint32_t j = 0; j < BENCH_N_FIELDS; j++)
+        {
+            if (strcmp(header[c], bench_fields[j].name) == 0)
+            {
+                *field(r, j) = strtod(tok, NULL);
+            }
+        }
+    }
+    return (r->op[0] != 0);
+}
+
+// Reads a file written with -f csv or -f json; returns the number of results.
+static uint32_t read_results(bench_result_t* r, const char* path)
+{
+    char line[1024];
+    char header[BENCH_N_FIELDS + 2][32];
+    uint32_t n_cols = 0;
+    uint32_t n = 0;
+    int csv = -1;
+
+    FILE* f = fopen(path, "r");
+    if (f == NULL)
+    {
+        printf("cannot read %s\n", path);
+        return 0;
+    }
+    while ((n < BENCH_MAX_RESULTS) && (fgets(line, sizeof(line), f) != NULL))
+    {
+        if (csv == -1)
+        {
+            csv = (line[0] != '{');
+            if (csv)
+            {
+                for (char* tok = strtok(line, ",\n"); (tok != NULL) && (n_cols < BENCH_N_FIELDS + 2);
+                        tok = strtok(NULL, ",\n"))
+                {
+                    snprintf(header[n_cols++], sizeof(header[0]), "%s", tok);
+                }
+                continue;
+            }
+        }
+        n += csv ? parse_csv_line(&r[n], line, header, n_cols) : parse_json_line(&r[n], line);
+    }
+    fclose(f);
+    return n;
+}
+
+// Slower beyond the threshold and outside the noise: the intervals of the
+// means (or of p99) do not overlap. Memory has no noise to speak of: peak
+// stack or heap above the threshold is flagged when both files have it.
+static int compare(const char* base_path, const char* new_path, const double threshold)
+{
+    bench_result_t base[BENCH_MAX_RESULTS];
+    bench_result_t cur[BENCH_MAX_RESULTS];
+    const uint32_t n_base = read_results(base, base_path);
+    const uint32_t n_cur = read_results(cur, new_path);
+    int regressions = 0;
+
+    if ((n_base == 0) || (n_cur == 0))
+    {
+        return 1;
+    }
+
+    printf("%-5s %-9s %12s %12s %8s %12s %12s %8s\n", "level", "op",
+           "base mean", "new mean", "change", "base p99", "new p99", "change");
+    for (uint32_t i = 0; i < n_cur; i++)
+    {
+        const bench_result_t* c = &cur[i];
+        const bench_result_t* b = NULL;
+        for (uint32_t j = 0; j < n_base; j++)
+        {
+            if ((base[j].level == c->level) && (strcmp(base[j].op, c->op) == 0))
+            {
+                b = &base[j];
+            }
+        }
+        if ((b == NULL) || (b->mean_ns <= 0) || (b->p99_ns <= 0))
+        {
+            printf("%-5u %-9s (not in %s)\n", c->level, c->op, base_path);
+            continue;
+        }
+
+        const double d_mean = 100.0 * (c->mean_ns / b->mean_ns - 1.0);
+        const double d_p99 = 100.0 * (c->p99_ns / b->p99_ns - 1.0);
+        const int slow_mean = (d_mean > threshold) && (c->mean_ns - c->ci95_ns > b->mean_ns + b->ci95_ns);
+        const int fast_mean = (d_mean < -threshold) && (c->mean_ns + c->ci95_ns < b->mean_ns - b->ci95_ns);
+        const int slow_p99 = (d_p99 > threshold) && (c->p99_lo_ns > b->p99_hi_ns);
+
+        printf("%-5u %-9s %10.1fus %10.1fus %+7.1f%% %10.1fus %10.1fus %+7.1f%%  %s%s\n",
+               c->level, c->op, b->mean_ns / 1000, c->mean_ns / 1000, d_mean,
+               b->p99_ns / 1000, c->p99_ns / 1000, d_p99,
+               slow_mean ? "REGRESSION " : (fast_mean ? "faster " : ""),
+               slow_p99 ? "p99 REGRESSION" : "");
+        regressions += slow_mean || slow_p99;
+
+        const double base_mem[2] = {b->stack_bytes, b->heap_bytes};
+        const double cur_mem[2] = {c->stack_bytes, c->heap_bytes};
+        const char* mem_names[2] = {"stack", "heap"};
+        for (uint32_t m = 0; m < 2; m++)
+        {
+            if ((base_mem[m] > 0) && (cur_mem[m] > 0) &&
+                (100.0 * (cur_mem[m] / base_mem[m] - 1.0) > threshold))
+            {
+                printf("%-5u %-9s %s %.0f -> %.0f bytes  MEMORY REGRESSION\n", c->level, c->op,
+                       mem_names[m], base_mem[m], cur_mem[m]);
+                regressions++;
+            }
+        }
+    }
+
+    printf("%d regression(s) beyond %.1f%%\n", regressions, threshold);
+    return (regressions > 0);
+}
+
+////////////////////////////////////////////////////////////////
+//   Main
+////////////////////////////////////////////////////////////////
+
+int main(int argc, char **argv)
+{
+    bench_result_t results[BENCH_MAX_RESULTS];
+    uint32_t levels[3];
+    uint32_t n_levels = 0;
+    const char* level_arg = "1";
+    const char* format = "csv";
+    const char* path = NULL;
+    const char* base_path = NULL;
+    double seconds = BENCH_DEFAULT_SECONDS;
+    double warmup = BENCH_DEFAULT_WARMUP;
+    double threshold = BENCH_DEFAULT_THRESHOLD;
+    const char* decoder = "bgf";
+    int mem = 0;
+    int ok = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l:d:w:mD:f:O:c:T:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'l': level_arg = optarg; break;
+        case 'd': seconds = atof(optarg); break;
+        case 'w': warmup = atof(optarg); break;
+        case 'm': mem = 1; break;
+        case 'D': decoder = optarg; break;
+        case 'f': format = optarg; break;
+        case 'O': path = optarg; break;
+        case 'c': base_path = optarg; break;
+        case 'T': threshold = atof(optarg); break;
+        default: ok = 0; break;
+        }
+    }
+
+    char levels_buf[32];
+    snprintf(levels_buf, sizeof(levels_buf), "%s", level_arg);
+    for (char* tok = strtok(levels_buf, ","); tok != NULL; tok = strtok(NULL, ","))
+    {
+        ok &= (n_levels < 3) && (bike_kem((uint32_t)atoi(tok)) != NULL);
+        if (ok)
+        {
+            levels[n_levels++] = (uint32_t)atoi(tok);
+        }
+    }
+
+    const int json = (strcmp(format, "json") == 0);
+    const int backflip = (strcmp(decoder, "backflip") == 0);
+    if (!ok || (n_levels == 0) || (seconds <= 0) || (warmup < 0) || (threshold < 0) ||
+        (!json && strcmp(format, "csv")) || (!backflip && strcmp(decoder, "bgf")) ||
+        ((base_path != NULL) && (optind + 1 != argc)))
+    {
+        printf("usage: %s [-l levels] [-d seconds] [-w warmup seconds] [-m] [-D bgf|backflip]\n"
+               "       %*s [-f csv|json] [-O file]\n"
+               "       %s -c base new [-T threshold %%]\n", argv[0], (int)strlen(argv[0]), "", argv[0]);
+        return 2;
+    }
+    if (base_path != NULL)
+    {
+        return compare(base_path, argv[optind], threshold);
+    }
+
+    printf("BIKE benchmark, %.1f s per operation after %.1f s of warmup\n", seconds, warmup);
+    printf("%-5s %-9s %9s %11s %20s %10s %10s %10s %10s", "level", "op", "calls", "ops/s",
+           "mean +- 95% CI (us)", "p50", "p90", "p99", "p99.9");
+    printf(mem ? " %9s %9s %7s\n" : "\n", "stack", "heap", "allocs");
+
+    hist_t* h = (hist_t*)malloc(sizeof(hist_t));
+    uint32_t n = 0;
+    int rc = (h == NULL);
+    for (uint32_t l = 0; (rc == 0) && (l < n_levels); l++)
+    {
+        bench_kem_t b;
+        if (!bench_kem_init(&b, bike_kem(levels[l]), backflip))
+        {
+            printf("level %u: setup failed\n", levels[l]);
+            rc = 1;
+            break;
+        }
+        for (uint32_t op = 0; op < OP_COUNT; op++, n++)
+        {
+            bench_result_t* r = &results[n];
+            memset(r, 0, sizeof(*r));
+            r->level = levels[l];
+            snprintf(r->op, sizeof(r->op), "%s%s", op_names[op],
+                     (backflip && (op == OP_DECAPS)) ? "-bf" : "");
+            if (bench_op(r, h, &b, (bench_op_t)op, seconds, warmup) != 0)
+            {
+                printf("level %u: %s failed\n", levels[l], op_names[op]);
+                rc = 1;
+            }
+            if (mem && (bench_mem(r, &b, (bench_op_t)op) != 0))
+            {
+                printf("level %u: %s failed\n", levels[l], op_names[op]);
+                rc = 1;
+            }
+            printf("%-5u %-9s %9.0f %11.1f %11.1f +- %6.2f %8.1fus %8.1fus %8.1fus %8.1fus",
+                   r->level, r->op, r->calls, r->ops_per_s, r->mean_ns / 1000, r->ci95_ns / 1000,
+                   r->p50_ns / 1000, r->p90_ns / 1000, r->p99_ns / 1000, r->p999_ns / 1000);
+            if (mem)
+            {
+                printf(" %9.0f %9.0f %7.0f", r->stack_bytes, r->heap_bytes, r->allocs);
+            }
+            printf("\n");
+        }
+        bench_kem_free(&b);
+    }
+    free(h);
+
+    if ((rc == 0) && (path != NULL))
+    {
+        FILE* f = fopen(path, "w");
+        if (f == NULL)
+        {
+            printf("cannot write %s\n", path);
+            return 1;
+        }
+        if (json)
+        {
+            write_json(f, results, n, seconds, warmup);
+        }
+        else
+        {
+            write_csv(f, results, n);
+        }
+        fclose(f);
+        printf("results written to %s\n", path);
+    }
+
+    return rc;
+}
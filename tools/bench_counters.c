@@ -0,0 +1,368 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// Benchmark of the counter engines (UPC_ENGINE, defs.h). At the configured
+// level it times the direct kernels the CPU supports, a bit-sliced counter
+// and the NTT engine on one block; then the runtime-r versions of the
+// direct, bit-sliced and NTT methods at larger research parameters, given
+// as r:dv arguments (dv <= 255). Every method is checked against the first.
+//   bike-counter-bench [r:dv ...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "dispatch.h"
+#include "decode_kernels.h"
+
+#define BENCH_RUNS 5
+#define BENCH_MIN_US 20000.0
+#define BENCH_TILE 128
+#define BENCH_PLANES 8
+
+// Research parameters of the second table when none are given.
+static const uint32_t default_params[][2] = {
+    {65537, 173}, {131101, 245}, {262147, 251}, {524309, 251}
+};
+
+////////////////////////////////////////////////////////////////
+//   Runtime-r methods
+////////////////////////////////////////////////////////////////
+
+// Direct: upc_block_portable with r known at run time (s_dup = s || s || 0,
+// both padded to whole tiles).
+static void direct_counters(OUT uint8_t* upc,
+        IN const uint8_t* s_dup,
+        IN const uint32_t r,
+        IN const uint32_t* col,
+        IN const uint32_t dv)
+{
+    for (uint32_t t = 0; t < r; t += BENCH_TILE)
+    {
+        // upc is padded to whole tiles
+        uint8_t* acc = upc + t;
+        memset(acc, 0, BENCH_TILE);
+
+        for (uint32_t i = 0; i < dv; i++)
+        {
+            const uint8_t* row = s_dup + col[i] + t;
+            for (uint32_t j = 0; j < BENCH_TILE; j++)
+            {
+                acc[j] += row[j];
+            }
+        }
+    }
+}
+
+// Bit-sliced: 64 positions per word, the counters held as BENCH_PLANES bit
+// planes; each column adds the 64 syndrome bits at its offset with a
+// ripple of half adders. s_bits is s || s || 0 packed LSB first.
+static void bitsliced_counters(OUT uint8_t* upc,
+        IN const uint64_t* s_bits,
+        IN const uint32_t r,
+        IN const uint32_t* col,
+        IN const uint32_t dv)
+{
+    for (uint32_t j0 = 0; j0 < r; j0 += 64)
+    {
+        uint64_t plane[BENCH_PLANES] = {0};
+
+        for (uint32_t i = 0; i < dv; i++)
+        {
+            const uint32_t bit = col[i] + j0;
+            const uint32_t w = bit / 64;
+            const uint32_t sh = bit % 64;
+            uint64_t carry = (sh == 0) ? s_bits[w] :
+                    ((s_bits[w] >> sh) | (s_bits[w + 1] << (64 - sh)));
+
+            // a full ripple: an early exit on carry == 0 mispredicts
+            for (uint32_t k = 0; k < BENCH_PLANES; k++)
+            {
+                const uint64_t t = plane[k] & carry;
+                plane[k] ^= carry;
+                carry = t;
+            }
+        }
+
+        const uint32_t n = ((r - j0) < 64) ? (r - j0) : 64;
+        for (uint32_t b = 0; b < n; b++)
+        {
+            uint8_t c = 0;
+            for (uint32_t k = 0; k < BENCH_PLANES; k++)
+            {
+                c |= (uint8_t)(((plane[k] >> b) & 1) << k);
+            }
+            upc[j0 + b] = c;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////
+//   Harness
+////////////////////////////////////////////////////////////////
+
+typedef struct bench_input_s
+{
+    uint32_t r;
+    uint32_t dv;
+    uint32_t* col;
+    uint8_t* s_dup;
+    uint64_t* s_bits;
+    uint8_t* ref;
+    uint8_t* upc;
+    ntt_ctr_t* ntt;
+} bench_input_t;
+
+typedef void (*method_t)(IN OUT bench_input_t* in);
+
+static upc_block_t g_kernel = NULL;
+
+static void method_direct(IN OUT bench_input_t* in)
+{
+    direct_counters(in->upc, in->s_dup, in->r, in->col, in->dv);
+}
+
+static void method_bitsliced(IN OUT bench_input_t* in)
+{
+    bitsliced_counters(in->upc, in->s_bits, in->r, in->col, in->dv);
+}
+
+static void method_ntt(IN OUT bench_input_t* in)
+{
+    ntt_ctr_compute(in->upc, in->s_dup, in->col, in->dv, in->ntt);
+}
+
+static void method_kernel(IN OUT bench_input_t* in)
+{
+    g_kernel(in->upc, in->s_dup, in->col, 0, R_PADDED_BITS);
+}
+
+// Best time of BENCH_RUNS runs (us per block); checks the output against
+// in->ref, or sets it when check is 0.
+static double time_method(IN OUT bench_input_t* in,
+        IN const method_t m,
+        IN const int check,
+        OUT int* ok)
+{
+    uint32_t reps = 1;
+    double best = 0;
+
+    for (;;)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t k = 0; k < reps; k++)
+        {
+            m(in);
+        }
+        const double us = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+        if ((us >= BENCH_MIN_US) || (reps >= (1U << 20)))
+        {
+            best = us / reps;
+            break;
+        }
+        reps *= 2;
+    }
+
+    for (uint32_t run = 1; run < BENCH_RUNS; run++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t k = 0; k < reps; k++)
+        {
+            m(in);
+        }
+        const double us = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count() / reps;
+        best = (us < best) ? us : best;
+    }
+
+    if (check)
+    {
+        *ok = (memcmp(in->upc, in->ref, in->r) == 0);
+    }
+    else
+    {
+        memcpy(in->ref, in->upc, in->r);
+        *ok = 1;
+    }
+
+    return best;
+}
+
+static int bench_alloc(OUT bench_input_t* in, IN const uint32_t r, IN const uint32_t dv)
+{
+    const uint32_t padded = r + 2*BENCH_TILE;
+    memset(in, 0, sizeof(*in));
+    in->r = r;
+    in->dv = dv;
+    in->col = (uint32_t*)malloc(dv * sizeof(uint32_t));
+    in->s_dup = (uint8_t*)calloc(2*padded, 1);
+    in->s_bits = (uint64_t*)calloc(2*padded/64 + 2, sizeof(uint64_t));
+    in->ref = (uint8_t*)malloc(padded);
+    in->upc = (uint8_t*)malloc(padded);
+    in->ntt = ntt_ctr_alloc(r);
+
+    if ((in->col == NULL) || (in->s_dup == NULL) || (in->s_bits == NULL) ||
+        (in->ref == NULL) || (in->upc == NULL) || (in->ntt == NULL))
+    {
+        return 0;
+    }
+
+    // distinct increasing column offsets and a syndrome of weight ~ r/4
+    for (uint32_t i = 0; i < dv; i++)
+    {
+        in->col[i] = (uint32_t)(((uint64_t)i * r) / dv) + (uint32_t)(rand() % (r / dv));
+    }
+    for (uint32_t i = 0; i < r; i++)
+    {
+        const uint8_t bit = ((rand() & 3) == 0);
+        in->s_dup[i] = bit;
+        in->s_dup[r + i] = bit;
+    }
+    for (uint32_t i = 0; i < 2*r; i++)
+    {
+        in->s_bits[i / 64] |= (uint64_t)in->s_dup[i] << (i % 64);
+    }
+
+    return 1;
+}
+
+static void bench_free(IN OUT bench_input_t* in)
+{
+    free(in->col);
+    free(in->s_dup);
+    free(in->s_bits);
+    free(in->ref);
+    free(in->upc);
+    ntt_ctr_free(in->ntt);
+}
+
+static void print_row(IN const bench_input_t* in,
+        IN const char* name,
+        IN const double us,
+        IN const int ok,
+        IN OUT uint32_t* failures)
+{
+    printf("  r=%-7u dv=%-4u %-18s %12.1f us%s\n", in->r, in->dv, name, us, ok ? "" : "  MISMATCH");
+    *failures += !ok;
+}
+
+// The direct kernels of this build that the CPU runs.
+static const struct
+{
+    bike_backend_t backend;
+    const char* name;
+    upc_block_t kernel;
+} kernels[] = {
+    {BIKE_BACKEND_PORTABLE, "direct (portable)", upc_block_portable},
+#ifdef DECODE_HAVE_AVX2
+    {BIKE_BACKEND_AVX2, "direct (avx2)", upc_block_avx2},
+#endif
+#ifdef DECODE_HAVE_AVX512
+    {BIKE_BACKEND_AVX512, "direct (avx512)", upc_block_avx512},
+#endif
+#ifdef DECODE_HAVE_NEON
+    {BIKE_BACKEND_NEON, "direct (neon)", upc_block_neon},
+#endif
+};
+
+int main(int argc, char **argv)
+{
+    bench_input_t in;
+    uint32_t failures = 0;
+    int ok;
+
+    printf("Counter engines, one block, level r=%u dv=%u:\n", (uint32_t)R_BITS, (uint32_t)DV);
+    if (!bench_alloc(&in, R_BITS, DV))
+    {
+        printf("allocation failed\n");
+        return 1;
+    }
+
+    for (uint32_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+        if ((kernels[k].backend != BIKE_BACKEND_PORTABLE) && !bike_backend_supported(kernels[k].backend))
+        {
+            continue;
+        }
+        g_kernel = kernels[k].kernel;
+        const double us = time_method(&in, method_kernel, k != 0, &ok);
+        print_row(&in, kernels[k].name, us, ok, &failures);
+    }
+    print_row(&in, "bit-sliced", time_method(&in, method_bitsliced, 1, &ok), ok, &failures);
+    print_row(&in, "ntt", time_method(&in, method_ntt, 1, &ok), ok, &failures);
+    bench_free(&in);
+
+    printf("Runtime-r methods:\n");
+    const uint32_t n_params = (argc > 1) ? (uint32_t)(argc - 1) :
+            (uint32_t)(sizeof(default_params) / sizeof(default_params[0]));
+
+    for (uint32_t p = 0; p < n_params; p++)
+    {
+        uint32_t r = 0, dv = 0;
+        if (argc > 1)
+        {
+            if ((sscanf(argv[p + 1], "%u:%u", &r, &dv) != 2) || (dv == 0) ||
+                (dv > NTT_CTR_MAX_DV) || (r < 2*dv))
+            {
+                printf("  bad parameter %s (r:dv, dv <= %u)\n", argv[p + 1], NTT_CTR_MAX_DV);
+                failures++;
+                continue;
+            }
+        }
+        else
+        {
+            r = default_params[p][0];
+            dv = default_params[p][1];
+        }
+
+        if (!bench_alloc(&in, r, dv))
+        {
+            printf("  r=%u: allocation failed\n", r);
+            bench_free(&in);
+            failures++;
+            continue;
+        }
+        print_row(&in, "direct", time_method(&in, method_direct, 0, &ok), ok, &failures);
+        print_row(&in, "bit-sliced", time_method(&in, method_bitsliced, 1, &ok), ok, &failures);
+        print_row(&in, "ntt", time_method(&in, method_ntt, 1, &ok), ok, &failures);
+        bench_free(&in);
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,499 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// Microbenchmark of the arithmetic and hashing primitives at the level
+// this is built for (make bike-kernel-bench builds levels 1, 3 and 5).
+// Every primitive runs on inputs shaped as in the KEM: a random key and an
+// error of weight T1 with its syndrome (dfr_trial.h), the ciphertext-sized
+// message of functionK, the error sampling of functionH. Each available
+// implementation is timed (cycles from perf_event_open, else ns; best of
+// BENCH_RUNS) per call and per unit of work, and checked against the first
+// implementation of the same primitive. Arguments select primitives by name.
+//   bike-kernel-bench-l<level> [primitive ...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "measurements.h"
+#include "dispatch.h"
+#include "workspace.h"
+#include "ntl.h"
+#include "hash_wrapper.h"
+#include "dfr_trial.h"
+
+#ifdef BIKE_LOW_MEM
+#error "bike-kernel-bench times the byte-per-bit decoder and NTL (not in BIKE_LOW_MEM)"
+#endif
+
+#define BENCH_RUNS 5
+#define BENCH_MIN_NS 20000000.0
+#define BENCH_SEED 1ULL
+
+// functionK hashes m || c0 || c1.
+#define MSG_K_SIZE (2*ELL_SIZE + R_SIZE)
+#define OUT_SIZE (2*R_BITS + UPC_PAD)
+
+typedef struct bench_ctx_s
+{
+    uint8_t out[OUT_SIZE] WS_ALIGNED;
+    uint8_t s_dup[S_DUP_SIZE] WS_ALIGNED;
+    uint8_t a[R_SIZE] WS_ALIGNED;
+    uint8_t h[R_SIZE] WS_ALIGNED;
+    uint64_t a64[R_QWORDS];
+    uint8_t s[R_BITS];
+    uint8_t e_packed[N_SIZE];
+    uint8_t msg[KECCAK_LANES][MSG_K_SIZE];
+    uint8_t keccak0[SHAKE256_STATE_SIZE];
+    uint8_t keccak[SHAKE256_STATE_SIZE];
+    uint8_t lanes[KECCAK_LANES][SHAKE256_STATE_SIZE];
+    keccak_multi_state_t multi0;
+    keccak_multi_state_t multi;
+    keccak_multi_state_t multi_prng0;
+    shake256_prng_state_t prng0;
+    shake256_prng_state_t prng;
+    uint32_t h0_col[DV];
+    uint32_t pos;
+    dfr_trial_t trial;
+    bike_ws_t* ws;
+} bench_ctx_t;
+
+typedef void (*bench_fn_t)(IN OUT bench_ctx_t* c);
+
+typedef struct bench_kernel_s
+{
+    const char* primitive;
+    const char* impl;
+    bike_backend_t backend;     // required backend
+    bench_fn_t run;             // timed; writes the result to c->out
+    bench_fn_t result;          // if not NULL, moves the result to c->out
+    uint32_t units;             // work per call
+    const char* unit;
+    uint32_t out_len;           // bytes of c->out compared, 0: not checked
+} bench_kernel_t;
+
+////////////////////////////////////////////////////////////////
+//   Kernels
+////////////////////////////////////////////////////////////////
+
+// c->a times h0, the syndrome product of decaps.
+static void mul_ntl(IN OUT bench_ctx_t* c) { ntl_mod_mul(c->out, c->a, c->h); }
+static void mul_portable(IN OUT bench_ctx_t* c) { gf2x_mod_mul_portable(c->out, c->a, c->h); }
+#ifdef GF2X_HAVE_PCLMUL
+static void mul_pclmul(IN OUT bench_ctx_t* c) { gf2x_mod_mul_pclmul(c->out, c->a, c->h); }
+#endif
+#ifdef GF2X_HAVE_NEON
+static void mul_neon(IN OUT bench_ctx_t* c) { gf2x_mod_mul_neon(c->out, c->a, c->h); }
+#endif
+static void mul_sparse(IN OUT bench_ctx_t* c)
+{
+    gf2x_mod_mul_sparse((uint64_t*)c->out, c->a64, c->trial.h0, DV);
+}
+
+// h0^-1, as in keygen.
+static void inv_ntl(IN OUT bench_ctx_t* c) { ntl_mod_inv(c->out, c->h); }
+static void inv_portable(IN OUT bench_ctx_t* c) { gf2x_mod_inv_portable(c->out, c->h); }
+#ifdef GF2X_HAVE_PCLMUL
+static void inv_pclmul(IN OUT bench_ctx_t* c) { gf2x_mod_inv_pclmul(c->out, c->h); }
+#endif
+#ifdef GF2X_HAVE_NEON
+static void inv_neon(IN OUT bench_ctx_t* c) { gf2x_mod_inv_neon(c->out, c->h); }
+#endif
+
+static void split(IN OUT bench_ctx_t* c) { gf2x_split(c->out, c->out + R_SIZE, c->e_packed); }
+
+// The counters of one block (the "ctr" step of every iteration).
+static void upc_portable(IN OUT bench_ctx_t* c) { upc_block_portable(c->out, c->s_dup, c->h0_col, 0, R_PADDED_BITS); }
+static void upc_ntt(IN OUT bench_ctx_t* c) { upc_block_ntt(c->out, c->s_dup, c->h0_col, 0, R_PADDED_BITS); }
+#ifdef DECODE_HAVE_AVX2
+static void upc_avx2(IN OUT bench_ctx_t* c) { upc_block_avx2(c->out, c->s_dup, c->h0_col, 0, R_PADDED_BITS); }
+#endif
+#ifdef DECODE_HAVE_AVX512
+static void upc_avx512(IN OUT bench_ctx_t* c) { upc_block_avx512(c->out, c->s_dup, c->h0_col, 0, R_PADDED_BITS); }
+#endif
+#ifdef DECODE_HAVE_NEON
+static void upc_neon(IN OUT bench_ctx_t* c) { upc_block_neon(c->out, c->s_dup, c->h0_col, 0, R_PADDED_BITS); }
+#endif
+
+// One flip of a position of e0 || e1 in the syndrome.
+static void recompute(IN OUT bench_ctx_t* c)
+{
+    recompute_syndrome(c->s, c->pos, c->trial.h0, c->trial.h1);
+    c->pos = (c->pos + 7919U) % N_BITS;
+}
+
+// Whole decodes of the trial's syndrome (restored first, as it is consumed).
+static void bgf(IN OUT bench_ctx_t* c)
+{
+    memcpy(c->s, c->trial.s, R_BITS);
+    memset(c->out, 0, N_BITS);
+    BGF_decoder_ws(c->out, c->s, c->trial.h0, c->trial.h1, c->ws);
+}
+static void backflip(IN OUT bench_ctx_t* c)
+{
+    memcpy(c->s, c->trial.s, R_BITS);
+    memset(c->out, 0, N_BITS);
+    backflip_decoder_ws(c->out, c->s, c->trial.h0, c->trial.h1, c->ws);
+}
+
+// The permutation on one state, and on KECCAK_LANES states (lane 0 is the
+// single state).
+static void keccak_x1(IN OUT bench_ctx_t* c) { KeccakF1600(c->keccak); }
+static void keccak_x1_words(IN OUT bench_ctx_t* c) { KeccakF1600_words(c->keccak); }
+static void keccak_x1_result(IN OUT bench_ctx_t* c) { memcpy(c->out, c->keccak, SHAKE256_STATE_SIZE); }
+static void keccak_multi_portable(IN OUT bench_ctx_t* c) { KeccakF1600_multi_portable(&c->multi); }
+#ifdef KECCAK_HAVE_AVX2
+static void keccak_multi_avx2(IN OUT bench_ctx_t* c) { KeccakF1600_multi_avx2(&c->multi); }
+#endif
+static void keccak_multi_result(IN OUT bench_ctx_t* c)
+{
+    keccak_multi_extract(c->lanes, &c->multi, SHAKE256_STATE_SIZE);
+    memcpy(c->out, c->lanes[0], SHAKE256_STATE_SIZE);
+}
+
+static void shake_prng(IN OUT bench_ctx_t* c) { shake256_prng(c->out, &c->prng, SHAKE256_BLOCK_SIZE); }
+
+static void sha3(IN OUT bench_ctx_t* c) { sha3_384(c->out, c->msg[0], MSG_K_SIZE); }
+static void sha3_multi(IN OUT bench_ctx_t* c)
+{
+    uint8_t* out[KECCAK_LANES];
+    const uint8_t* in[KECCAK_LANES];
+    for (uint32_t l = 0; l < KECCAK_LANES; l++)
+    {
+        out[l] = c->out + l * SHA384_HASH_SIZE;
+        in[l] = c->msg[l];
+    }
+    sha3_384_multi(out, in, MSG_K_SIZE);
+}
+
+// An error of weight T1 as functionH draws it (from a fresh stream).
+static void sample(IN OUT bench_ctx_t* c)
+{
+    c->prng = c->prng0;
+    memset(c->out, 0, N_SIZE);
+    generate_sparse_rep_keccak(c->out, T1, N_BITS, &c->prng);
+}
+static void sample_multi(IN OUT bench_ctx_t* c)
+{
+    uint8_t* r[KECCAK_LANES];
+    for (uint32_t l = 0; l < KECCAK_LANES; l++)
+    {
+        r[l] = c->out + l * N_SIZE;
+    }
+    c->multi = c->multi_prng0;
+    memset(c->out, 0, KECCAK_LANES * N_SIZE);
+    generate_sparse_rep_keccak_multi(r, T1, N_BITS, &c->multi);
+}
+
+// The conversions OR into their output, so it is cleared first (as the
+// callers do).
+static void to_bits_portable(IN OUT bench_ctx_t* c)
+{
+    memset(c->out, 0, N_BITS);
+    convertByteToBinary_portable(c->out, c->e_packed, N_BITS);
+}
+static void to_bytes_portable(IN OUT bench_ctx_t* c)
+{
+    memset(c->out, 0, N_SIZE);
+    convertBinaryToByte_portable(c->out, c->trial.e_true, N_BITS);
+}
+#ifdef CONVERSIONS_HAVE_AVX2
+static void to_bits_avx2(IN OUT bench_ctx_t* c)
+{
+    memset(c->out, 0, N_BITS);
+    convertByteToBinary_avx2(c->out, c->e_packed, N_BITS);
+}
+static void to_bytes_avx2(IN OUT bench_ctx_t* c)
+{
+    memset(c->out, 0, N_SIZE);
+    convertBinaryToByte_avx2(c->out, c->trial.e_true, N_BITS);
+}
+#endif
+
+#define P BIKE_BACKEND_PORTABLE
+static const bench_kernel_t kernels[] = {
+    {"gf2x_mod_mul", "ntl", P, mul_ntl, NULL, R_SIZE, "byte", R_SIZE},
+    {"gf2x_mod_mul", "karatsuba", P, mul_portable, NULL, R_SIZE, "byte", R_SIZE},
+#ifdef GF2X_HAVE_PCLMUL
+    {"gf2x_mod_mul", "pclmul", BIKE_BACKEND_PCLMUL, mul_pclmul, NULL, R_SIZE, "byte", R_SIZE},
+#endif
+#ifdef GF2X_HAVE_NEON
+    {"gf2x_mod_mul", "neon", BIKE_BACKEND_NEON, mul_neon, NULL, R_SIZE, "byte", R_SIZE},
+#endif
+    {"gf2x_mod_mul", "sparse (h0)", P, mul_sparse, NULL, R_SIZE, "byte", R_SIZE},
+    {"gf2x_mod_inv", "ntl", P, inv_ntl, NULL, R_SIZE, "byte", R_SIZE},
+    {"gf2x_mod_inv", "itoh-tsujii", P, inv_portable, NULL, R_SIZE, "byte", R_SIZE},
+#ifdef GF2X_HAVE_PCLMUL
+    {"gf2x_mod_inv", "itoh-tsujii pclmul", BIKE_BACKEND_PCLMUL, inv_pclmul, NULL, R_SIZE, "byte", R_SIZE},
+#endif
+#ifdef GF2X_HAVE_NEON
+    {"gf2x_mod_inv", "itoh-tsujii neon", BIKE_BACKEND_NEON, inv_neon, NULL, R_SIZE, "byte", R_SIZE},
+#endif
+    {"gf2x_split", "portable", P, split, NULL, N_SIZE, "byte", 2*R_SIZE},
+    {"upc_block", "portable", P, upc_portable, NULL, R_BITS, "bit", R_BITS},
+#ifdef DECODE_HAVE_AVX2
+    {"upc_block", "avx2", BIKE_BACKEND_AVX2, upc_avx2, NULL, R_BITS, "bit", R_BITS},
+#endif
+#ifdef DECODE_HAVE_AVX512
+    {"upc_block", "avx512", BIKE_BACKEND_AVX512, upc_avx512, NULL, R_BITS, "bit", R_BITS},
+#endif
+#ifdef DECODE_HAVE_NEON
+    {"upc_block", "neon", BIKE_BACKEND_NEON, upc_neon, NULL, R_BITS, "bit", R_BITS},
+#endif
+    {"upc_block", "ntt", P, upc_ntt, NULL, R_BITS, "bit", R_BITS},
+    {"recompute_syndrome", "portable", P, recompute, NULL, 2*DV, "bit", 0},
+    {"decoder", "BGF", P, bgf, NULL, N_BITS, "bit", N_BITS},
+    {"decoder", "backflip", P, backflip, NULL, N_BITS, "bit", N_BITS},
+    {"KeccakF1600", "x1", P, keccak_x1, keccak_x1_result, SHAKE256_STATE_SIZE, "byte", SHAKE256_STATE_SIZE},
+    {"KeccakF1600", "x1 words", P, keccak_x1_words, keccak_x1_result, SHAKE256_STATE_SIZE, "byte", SHAKE256_STATE_SIZE},
+    {"KeccakF1600", "multi portable", P, keccak_multi_portable, keccak_multi_result,
+        KECCAK_LANES * SHAKE256_STATE_SIZE, "byte", SHAKE256_STATE_SIZE},
+#ifdef KECCAK_HAVE_AVX2
+    {"KeccakF1600", "multi avx2", BIKE_BACKEND_AVX2, keccak_multi_avx2, keccak_multi_result,
+        KECCAK_LANES * SHAKE256_STATE_SIZE, "byte", SHAKE256_STATE_SIZE},
+#endif
+    {"shake256_prng", "x1", P, shake_prng, NULL, SHAKE256_BLOCK_SIZE, "byte", 0},
+    {"sha3_384", "openssl", P, sha3, NULL, MSG_K_SIZE, "byte", SHA384_HASH_SIZE},
+    {"sha3_384", "multi", P, sha3_multi, NULL, KECCAK_LANES * MSG_K_SIZE, "byte", SHA384_HASH_SIZE},
+    {"generate_sparse_rep", "x1", P, sample, NULL, T1, "pos", N_SIZE},
+    {"generate_sparse_rep", "multi", P, sample_multi, NULL, KECCAK_LANES * T1, "pos", N_SIZE},
+    {"convertByteToBinary", "portable", P, to_bits_portable, NULL, N_BITS, "bit", N_BITS},
+#ifdef CONVERSIONS_HAVE_AVX2
+    {"convertByteToBinary", "avx2", BIKE_BACKEND_AVX2, to_bits_avx2, NULL, N_BITS, "bit", N_BITS},
+#endif
+    {"convertBinaryToByte", "portable", P, to_bytes_portable, NULL, N_BITS, "bit", N_SIZE},
+#ifdef CONVERSIONS_HAVE_AVX2
+    {"convertBinaryToByte", "avx2", BIKE_BACKEND_AVX2, to_bytes_avx2, NULL, N_BITS, "bit", N_SIZE},
+#endif
+};
+#undef P
+#define N_KERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+////////////////////////////////////////////////////////////////
+//   Harness
+////////////////////////////////////////////////////////////////
+
+// shake256_prng draws at most one block past its position.
+static void prng_fill(OUT uint8_t* out, IN OUT shake256_prng_state_t* prng, IN uint32_t len)
+{
+    for (uint32_t n; len > 0; out += n, len -= n)
+    {
+        n = (len < SHAKE256_BLOCK_SIZE) ? len : (uint32_t)SHAKE256_BLOCK_SIZE;
+        shake256_prng(out, prng, n);
+    }
+}
+
+// The inputs of every kernel from one SHAKE256 stream.
+static int bench_init(OUT bench_ctx_t* c)
+{
+    shake256_prng_state_t prng;
+    uint8_t seed[KECCAK_LANES][ELL_SIZE];
+    const uint8_t* seeds[KECCAK_LANES];
+
+    c->ws = bike_ws_alloc();
+    if (c->ws == NULL)
+    {
+        return 0;
+    }
+    dfr_batch_prng(&prng, BENCH_SEED, 0);
+    dfr_sample_key(&c->trial, &prng);
+    dfr_sample_error(&c->trial, T1, &prng);
+
+    // a dense a (no bits above R_BITS) and h0 as a polynomial
+    prng_fill(c->a, &prng, R_SIZE);
+    c->a[R_SIZE - 1] &= (uint8_t)((1U << (R_BITS % 8 ? R_BITS % 8 : 8)) - 1);
+    memset(c->a64, 0, sizeof(c->a64));
+    memcpy(c->a64, c->a, R_SIZE);
+    memset(c->h, 0, R_SIZE);
+    for (uint32_t i = 0; i < DV; i++)
+    {
+        c->h[c->trial.h0[i] / 8] |= (uint8_t)(1U << (c->trial.h0[i] % 8));
+    }
+
+    memset(c->e_packed, 0, N_SIZE);
+    convertBinaryToByte_portable(c->e_packed, c->trial.e_true, N_BITS);
+    getCol(c->h0_col, c->trial.h0);
+    dup_syndrome(c->s_dup, c->trial.s);
+    memcpy(c->s, c->trial.s, R_BITS);
+
+    prng_fill((uint8_t*)c->msg, &prng, sizeof(c->msg));
+    prng_fill(c->keccak0, &prng, SHAKE256_STATE_SIZE);
+    prng_fill((uint8_t*)&c->multi0, &prng, sizeof(c->multi0));
+    for (uint32_t w = 0; w < 25; w++)
+    {
+        memcpy(&c->multi0.A[w][0], c->keccak0 + 8*w, 8);
+    }
+
+    prng_fill((uint8_t*)seed, &prng, sizeof(seed));
+    for (uint32_t l = 0; l < KECCAK_LANES; l++)
+    {
+        seeds[l] = seed[l];
+    }
+    memset(&c->prng0, 0, sizeof(c->prng0));
+    shake256_init(seed[0], ELL_SIZE, &c->prng0);
+    shake256_multi_init(seeds, ELL_SIZE, &c->multi_prng0);
+
+    return 1;
+}
+
+// Puts the mutable inputs back to their initial values.
+static void bench_reset(IN OUT bench_ctx_t* c)
+{
+    memcpy(c->keccak, c->keccak0, SHAKE256_STATE_SIZE);
+    c->multi = c->multi0;
+    c->prng = c->prng0;
+    memcpy(c->s, c->trial.s, R_BITS);
+    c->pos = 0;
+}
+
+// Best cost per call of BENCH_RUNS runs, in cycles when perf counts them.
+static double time_kernel(IN OUT bench_ctx_t* c, IN const bench_kernel_t* k, IN perf_group_t* g)
+{
+    perf_sample_t s;
+    uint32_t reps = 1;
+    double best = 0;
+
+    for (;;)
+    {
+        perf_group_start(g);
+        for (uint32_t i = 0; i < reps; i++)
+        {
+            k->run(c);
+        }
+        perf_group_stop(g, &s);
+        if ((s.ns >= BENCH_MIN_NS / BENCH_RUNS) || (reps >= (1U << 24)))
+        {
+            break;
+        }
+        reps *= 2;
+    }
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++)
+    {
+        perf_group_start(g);
+        for (uint32_t i = 0; i < reps; i++)
+        {
+            k->run(c);
+        }
+        perf_group_stop(g, &s);
+        const double v = ((s.valid & (1U << PERF_EV_CYCLES)) ? s.ev[PERF_EV_CYCLES] : s.ns) / reps;
+        best = ((run == 0) || (v < best)) ? v : best;
+    }
+
+    return best;
+}
+
+static int selected(IN const char* primitive, IN const int argc, IN char** argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], primitive) == 0)
+        {
+            return 1;
+        }
+    }
+    return (argc < 2);
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t ref[OUT_SIZE];
+    perf_group_t g;
+    uint32_t failures = 0;
+    bench_ctx_t* c = NULL;
+
+    if ((posix_memalign((void**)&c, BIKE_WS_ALIGN, sizeof(bench_ctx_t)) != 0) || !bench_init(c))
+    {
+        printf("allocation failed\n");
+        return 1;
+    }
+    perf_group_open(&g);
+    const char* unit = (g.fd[PERF_EV_CYCLES] != -1) ? "cycles" : "ns";
+
+    printf("Kernels at r=%u dv=%u t=%u, %u Keccak lanes, decoder backend %s, in %s:\n",
+           (uint32_t)R_BITS, (uint32_t)DV, (uint32_t)T1, (uint32_t)KECCAK_LANES,
+           bike_dispatch()->name, unit);
+    printf("  %-20s %-20s %14s %18s  %s\n", "primitive", "implementation",
+           "per call", "per unit", "check");
+
+    const char* primitive = "";
+    for (uint32_t i = 0; i < N_KERNELS; i++)
+    {
+        const bench_kernel_t* k = &kernels[i];
+        const int first = (strcmp(k->primitive, primitive) != 0);
+        primitive = k->primitive;
+
+        if (!selected(k->primitive, argc, argv) ||
+            ((k->backend != BIKE_BACKEND_PORTABLE) && !bike_backend_supported(k->backend)))
+        {
+            continue;
+        }
+
+        // the output of one call from the initial inputs
+        bench_reset(c);
+        k->run(c);
+        if (k->result != NULL)
+        {
+            k->result(c);
+        }
+        const char* check = "-";
+        if (k->out_len != 0)
+        {
+            if (first)
+            {
+                memcpy(ref, c->out, k->out_len);
+                check = "ref";
+            }
+            else
+            {
+                const int ok = (memcmp(ref, c->out, k->out_len) == 0);
+                check = ok ? "OK" : "MISMATCH";
+                failures += !ok;
+            }
+        }
+
+        bench_reset(c);
+        const double per_call = time_kernel(c, k, &g);
+        printf("  %-20s %-20s %14.0f %12.3f/%-5s  %s\n", first ? k->primitive : "", k->impl,
+               per_call, per_call / k->units, k->unit, check);
+    }
+
+    perf_group_close(&g);
+    bike_ws_free(c->ws);
+    free(c);
+    return failures ? 1 : 0;
+}
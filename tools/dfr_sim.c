@@ -0,0 +1,475 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// Monte-Carlo estimate of the decoding failure rate (DFR) of the
+// configured level. Every trial samples an error of the given weight,
+// computes its syndrome e0*h0 + e1*h1 directly from the supports (no KEM
+// hashing) and runs BGF_decoder_stats_ws, or backflip_decoder_ws with
+// -D backflip (without the per-iteration report). Trials run in batches of one key
+// each; batch b draws everything from SHAKE256(seed || b), so the counts do
+// not depend on the thread count and a resumed run continues exactly.
+// Worker threads claim batches and add their counts with atomics. Between
+// rounds of about one report interval, the totals are written to the
+// checkpoint file, and an existing one is resumed (with its seed, weight
+// and batch size). -n is rounded up to whole batches: -n 100000 -b 1024
+// runs 98 batches, 100352 trials.
+//   bike-dfr-sim [-n trials] [-t threads] [-w weight] [-b trials per key]
+//                [-s seed] [-D bgf|backflip] [-c checkpoint] [-i seconds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <chrono>
+
+#include "workspace.h"
+#include "dfr_trial.h"
+
+#ifdef BIKE_LOW_MEM
+#error "bike-dfr-sim runs the byte-per-bit BGF decoder (not in BIKE_LOW_MEM)"
+#endif
+
+#define DFR_DEFAULT_TRIALS 100000ULL
+#define DFR_DEFAULT_BATCH 1024U
+#define DFR_DEFAULT_INTERVAL 60U
+#define DFR_MAX_THREADS 256U
+#define DFR_CHECKPOINT_VERSION 2U
+
+typedef struct dfr_totals_s
+{
+    uint64_t trials;
+    // syndrome not cleared
+    uint64_t failures;
+    // syndrome cleared by an error other than the sampled one
+    uint64_t wrong;
+    // done_at[i]: successes whose syndrome was 0 after iteration i
+    uint64_t done_at[NbIter + 1];
+    // weight_sum[i]: syndrome weight before iteration i + 1 (after NbIter
+    // for i = NbIter), summed over all trials
+    uint64_t weight_sum[NbIter + 1];
+} dfr_totals_t;
+
+typedef struct dfr_run_s
+{
+    uint64_t seed;
+    uint32_t weight;
+    uint32_t batch;
+    // DECODER_BGF or DECODER_BACKFLIP
+    uint32_t decoder;
+    uint64_t n_batches;
+    // batches [0, next_batch) are in totals
+    uint64_t next_batch;
+    // the running round: batches below round_end, claimed from claim
+    uint64_t round_end;
+    uint64_t claim;
+    uint32_t failed_threads;
+    dfr_totals_t totals;
+} dfr_run_t;
+
+////////////////////////////////////////////////////////////////
+//   Trials
+////////////////////////////////////////////////////////////////
+
+static void run_trial(IN OUT dfr_trial_t* t,
+        IN const uint32_t weight,
+        IN const uint32_t decoder,
+        IN OUT shake256_prng_state_t* prng,
+        IN OUT bike_ws_t* ws,
+        IN OUT dfr_totals_t* totals)
+{
+    bgf_stats_t stats;
+
+    dfr_sample_error(t, weight, prng);
+
+    if (decoder == DECODER_BACKFLIP)
+    {
+        const int rc = backflip_decoder_ws(t->e, t->s, t->h0, t->h1, ws);
+
+        totals->trials++;
+        if (rc != 0)
+        {
+            totals->failures++;
+        }
+        else if (memcmp(t->e, t->e_true, 2*R_BITS) != 0)
+        {
+            totals->wrong++;
+        }
+        return;
+    }
+
+    const int rc = BGF_decoder_stats_ws(t->e, t->s, t->h0, t->h1, &stats, ws);
+
+    totals->trials++;
+    for (uint32_t i = 0; i <= NbIter; i++)
+    {
+        totals->weight_sum[i] += stats.syndrome_weight[i];
+    }
+
+    if (rc != 0)
+    {
+        totals->failures++;
+    }
+    else if (memcmp(t->e, t->e_true, 2*R_BITS) != 0)
+    {
+        totals->wrong++;
+    }
+    else
+    {
+        uint32_t i = 1;
+        while (stats.syndrome_weight[i] != 0)
+        {
+            i++;
+        }
+        totals->done_at[i]++;
+    }
+}
+
+static void run_batch(IN const dfr_run_t* run,
+        IN const uint64_t b,
+        IN OUT dfr_trial_t* t,
+        IN OUT bike_ws_t* ws,
+        OUT dfr_totals_t* totals)
+{
+    shake256_prng_state_t prng;
+
+    dfr_batch_prng(&prng, run->seed, b);
+    memset(totals, 0, sizeof(*totals));
+    dfr_sample_key(t, &prng);
+
+    for (uint32_t k = 0; k < run->batch; k++)
+    {
+        run_trial(t, run->weight, run->decoder, &prng, ws, totals);
+    }
+}
+
+static void add_totals(IN OUT dfr_totals_t* dst, IN const dfr_totals_t* src)
+{
+    __atomic_fetch_add(&dst->trials, src->trials, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&dst->failures, src->failures, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&dst->wrong, src->wrong, __ATOMIC_RELAXED);
+    for (uint32_t i = 0; i <= NbIter; i++)
+    {
+        __atomic_fetch_add(&dst->done_at[i], src->done_at[i], __ATOMIC_RELAXED);
+        __atomic_fetch_add(&dst->weight_sum[i], src->weight_sum[i], __ATOMIC_RELAXED);
+    }
+}
+
+static void* dfr_worker(IN void* arg)
+{
+    dfr_run_t* run = (dfr_run_t*)arg;
+    dfr_trial_t* t = (dfr_trial_t*)malloc(sizeof(dfr_trial_t));
+    bike_ws_t* ws = bike_ws_alloc();
+
+    if ((t == NULL) || (ws == NULL))
+    {
+        __atomic_fetch_add(&run->failed_threads, 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        dfr_totals_t local;
+        uint64_t b;
+        while ((b = __atomic_fetch_add(&run->claim, 1, __ATOMIC_RELAXED)) < run->round_end)
+        {
+            run_batch(run, b, t, ws, &local);
+            add_totals(&run->totals, &local);
+        }
+    }
+
+    bike_ws_free(ws);
+    free(t);
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////
+//   Checkpoints and report
+////////////////////////////////////////////////////////////////
+
+static int save_checkpoint(IN const char* path, IN const dfr_run_t* run)
+{
+    char tmp[4096];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+    FILE* f = fopen(tmp, "w");
+    if (f == NULL)
+    {
+        return 0;
+    }
+
+    const dfr_totals_t* c = &run->totals;
+    fprintf(f, "bike-dfr-sim %u\n", DFR_CHECKPOINT_VERSION);
+    fprintf(f, "r %u\ndv %u\nnbiter %u\n", (uint32_t)R_BITS, (uint32_t)DV, (uint32_t)NbIter);
+    fprintf(f, "seed %llu\nweight %u\nbatch %u\ndecoder %u\n",
+            (unsigned long long)run->seed, run->weight, run->batch, run->decoder);
+    fprintf(f, "next_batch %llu\ntrials %llu\nfailures %llu\nwrong %llu\n",
+            (unsigned long long)run->next_batch, (unsigned long long)c->trials,
+            (unsigned long long)c->failures, (unsigned long long)c->wrong);
+    fprintf(f, "done_at");
+    for (uint32_t i = 0; i <= NbIter; i++)
+    {
+        fprintf(f, " %llu", (unsigned long long)c->done_at[i]);
+    }
+    fprintf(f, "\nweight_sum");
+    for (uint32_t i = 0; i <= NbIter; i++)
+    {
+        fprintf(f, " %llu", (unsigned long long)c->weight_sum[i]);
+    }
+    fprintf(f, "\n");
+
+    const int ok = (fclose(f) == 0);
+    return ok && (rename(tmp, path) == 0);
+}
+
+// Returns 1 when the file was resumed, 0 when it does not exist, -1 when it
+// does not belong to this build or is damaged.
+static int load_checkpoint(IN const char* path, OUT dfr_run_t* run)
+{
+    FILE* f = fopen(path, "r");
+    if (f == NULL)
+    {
+        return 0;
+    }
+
+    unsigned long long v[9] = {0};
+    dfr_totals_t* c = &run->totals;
+    int ok = (fscanf(f, "bike-dfr-sim %llu r %llu dv %llu nbiter %llu seed %llu weight %llu batch %llu decoder %llu",
+            &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]) == 8) &&
+            (v[0] == DFR_CHECKPOINT_VERSION) && (v[1] == R_BITS) && (v[2] == DV) && (v[3] == NbIter);
+    run->seed = v[4];
+    run->weight = (uint32_t)v[5];
+    run->batch = (uint32_t)v[6];
+    run->decoder = (uint32_t)v[7];
+
+    unsigned long long next = 0, trials = 0, failures = 0, wrong = 0;
+    ok = ok && (fscanf(f, " next_batch %llu trials %llu failures %llu wrong %llu done_at",
+            &next, &trials, &failures, &wrong) == 4);
+    run->next_batch = next;
+    c->trials = trials;
+    c->failures = failures;
+    c->wrong = wrong;
+    for (uint32_t i = 0; ok && (i <= NbIter); i++)
+    {
+        ok = (fscanf(f, "%llu", &v[0]) == 1);
+        c->done_at[i] = v[0];
+    }
+    ok = ok && (fscanf(f, " weight_sum") == 0);
+    for (uint32_t i = 0; ok && (i <= NbIter); i++)
+    {
+        ok = (fscanf(f, "%llu", &v[0]) == 1);
+        c->weight_sum[i] = v[0];
+    }
+    fclose(f);
+
+    ok = ok && (run->weight > 0) && (run->weight < N_BITS) && (run->batch > 0) &&
+            ((run->decoder == DECODER_BGF) || (run->decoder == DECODER_BACKFLIP)) &&
+            (c->trials == run->next_batch * run->batch);
+    return ok ? 1 : -1;
+}
+
+static double log2_or_inf(IN const double x)
+{
+    return (x > 0.0) ? log2(x) : -INFINITY;
+}
+
+static void report(IN const dfr_run_t* run, IN const double rate)
+{
+    const dfr_totals_t* c = &run->totals;
+    const uint64_t fails = c->failures + c->wrong;
+    double lo, hi;
+
+    if (c->trials == 0)
+    {
+        return;
+    }
+
+    dfr_wilson(fails, c->trials, &lo, &hi);
+    MSG("  %llu trials (%.0f/s), %llu failures (%llu wrong codewords): DFR %.3e = 2^%.2f, "
+        "95%% CI [2^%.2f, 2^%.2f]\n",
+        (unsigned long long)c->trials, rate, (unsigned long long)fails,
+        (unsigned long long)c->wrong, (double)fails / c->trials,
+        log2_or_inf((double)fails / c->trials), log2_or_inf(lo), log2_or_inf(hi));
+}
+
+static void report_iterations(IN const dfr_run_t* run)
+{
+    const dfr_totals_t* c = &run->totals;
+    uint64_t done = 0;
+
+    MSG("  iteration  mean |s| before  decoded after\n");
+    for (uint32_t i = 1; i <= NbIter; i++)
+    {
+        done += c->done_at[i];
+        MSG("  %9u  %14.1f  %12.6f\n", i, (double)c->weight_sum[i - 1] / c->trials,
+            (double)done / c->trials);
+    }
+    MSG("  mean |s| after the last iteration: %.3f\n", (double)c->weight_sum[NbIter] / c->trials);
+}
+
+int main(int argc, char **argv)
+{
+    dfr_run_t run;
+    uint64_t trials = DFR_DEFAULT_TRIALS;
+    uint32_t interval = DFR_DEFAULT_INTERVAL;
+    const char* checkpoint = NULL;
+    const char* decoder = "bgf";
+    const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t n_threads = (ncpu > 0) ? (uint32_t)ncpu : 1;
+    int opt;
+
+    memset(&run, 0, sizeof(run));
+    run.seed = 1;
+    run.weight = T1;
+    run.batch = DFR_DEFAULT_BATCH;
+
+    while ((opt = getopt(argc, argv, "n:t:w:b:s:D:c:i:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': trials = strtoull(optarg, NULL, 0); break;
+        case 't': n_threads = (uint32_t)atoi(optarg); break;
+        case 'w': run.weight = (uint32_t)atoi(optarg); break;
+        case 'b': run.batch = (uint32_t)atoi(optarg); break;
+        case 's': run.seed = strtoull(optarg, NULL, 0); break;
+        case 'D': decoder = optarg; break;
+        case 'c': checkpoint = optarg; break;
+        case 'i': interval = (uint32_t)atoi(optarg); break;
+        default:
+            MSG("usage: %s [-n trials] [-t threads] [-w weight] [-b trials per key] "
+                "[-s seed] [-D bgf|backflip] [-c checkpoint] [-i seconds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (strcmp(decoder, "backflip") == 0)
+    {
+        run.decoder = DECODER_BACKFLIP;
+    }
+    else if (strcmp(decoder, "bgf") != 0)
+    {
+        MSG("bad arguments\n");
+        return 1;
+    }
+
+    if (checkpoint != NULL)
+    {
+        const int rc = load_checkpoint(checkpoint, &run);
+        if (rc < 0)
+        {
+            MSG("%s is not a checkpoint of this level\n", checkpoint);
+            return 1;
+        }
+        if (rc > 0)
+        {
+            MSG("Resuming %s at %llu trials (seed, weight, batch and decoder of the checkpoint)\n",
+                checkpoint, (unsigned long long)run.totals.trials);
+        }
+    }
+
+    if ((run.weight == 0) || (run.weight >= N_BITS) || (run.batch == 0) ||
+        (n_threads == 0) || (n_threads > DFR_MAX_THREADS) || (interval == 0))
+    {
+        MSG("bad arguments\n");
+        return 1;
+    }
+    run.n_batches = (trials + run.batch - 1) / run.batch;
+
+    MSG("BIKE DFR simulation, %s decoder, r: %d, dv: %d, error weight: %u, %llu trials, "
+        "%u trials per key, %u threads, seed %llu\n",
+        (run.decoder == DECODER_BACKFLIP) ? "Backflip" : "BGF", (int)R_BITS, (int)DV, run.weight,
+        (unsigned long long)(run.n_batches * run.batch), run.batch, n_threads,
+        (unsigned long long)run.seed);
+
+    // the first round gives every thread one batch to measure the speed
+    uint64_t round = n_threads;
+    while (run.next_batch < run.n_batches)
+    {
+        pthread_t threads[DFR_MAX_THREADS];
+        uint32_t started = 0;
+
+        run.round_end = run.next_batch + round;
+        if (run.round_end > run.n_batches)
+        {
+            run.round_end = run.n_batches;
+        }
+        run.claim = run.next_batch;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (; started < n_threads; started++)
+        {
+            if (pthread_create(&threads[started], NULL, dfr_worker, &run) != 0)
+            {
+                break;
+            }
+        }
+        for (uint32_t i = 0; i < started; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+        const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // every batch of the round is done once at least one thread ran
+        if ((started == 0) || (run.failed_threads == started))
+        {
+            MSG("cannot start the worker threads\n");
+            return 1;
+        }
+        run.failed_threads = 0;
+
+        const uint64_t done = run.round_end - run.next_batch;
+        run.next_batch = run.round_end;
+        if ((checkpoint != NULL) && !save_checkpoint(checkpoint, &run))
+        {
+            MSG("cannot write %s\n", checkpoint);
+            return 1;
+        }
+
+        const double rate = (sec > 0.0) ? (done * run.batch / sec) : 0.0;
+        report(&run, rate);
+
+        // the next round takes about one report interval
+        const double next = (sec > 0.0) ? (done * interval / sec) : (double)done;
+        round = (next > (double)n_threads) ? (uint64_t)next : n_threads;
+    }
+
+    if ((run.totals.trials > 0) && (run.decoder == DECODER_BGF))
+    {
+        report_iterations(&run);
+    }
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// Trials shared by the decoder tools (bike-dfr-sim, bike-autotune): a key
+// and an error of a given weight drawn from a SHAKE256 stream, with the
+// syndrome e0*h0 + e1*h1 computed from the supports, transposed as in
+// compute_syndrome.
+
+#ifndef _DFR_TRIAL_H_
+#define _DFR_TRIAL_H_
+
+#include <string.h>
+#include <math.h>
+
+#include "decode.h"
+#include "sampling.h"
+#include "shake_prng.h"
+
+// two-sided 95% normal quantile of the Wilson score interval
+#define DFR_Z 1.959963984540054
+
+// Per-thread buffers of one trial.
+typedef struct dfr_trial_s
+{
+    uint8_t s_row[R_BITS];
+    uint8_t s[R_BITS];
+    uint8_t e[2*R_BITS];
+    uint8_t e_true[2*R_BITS];
+    uint8_t mark[R_BITS];
+    uint32_t e_pos[N_BITS];
+    uint32_t h0[DV];
+    uint32_t h1[DV];
+} dfr_trial_t;
+
+// n distinct positions below len, marked in mark[len]; out (if not NULL)
+// receives them in the order drawn.
+_INLINE_ void sample_positions(OUT uint32_t* out,
+        OUT uint8_t* mark,
+        IN const uint32_t n,
+        IN const uint32_t len,
+        IN OUT shake256_prng_state_t* prng)
+{
+    memset(mark, 0, len);
+    for (uint32_t k = 0; k < n; )
+    {
+        uint32_t pos;
+        get_rand_mod_len_keccak(&pos, len, prng);
+        if (!mark[pos])
+        {
+            mark[pos] = 1;
+            if (out != NULL)
+            {
+                out[k] = pos;
+            }
+            k++;
+        }
+    }
+}
+
+// The support of a key block in increasing order, as convert2compact.
+_INLINE_ void sample_key_block(OUT uint32_t h[DV],
+        IN OUT dfr_trial_t* t,
+        IN OUT shake256_prng_state_t* prng)
+{
+    sample_positions(NULL, t->mark, DV, R_BITS, prng);
+    for (uint32_t i = 0, k = 0; i < R_BITS; i++)
+    {
+        if (t->mark[i])
+        {
+            h[k++] = i;
+        }
+    }
+}
+
+// The stream of batch b of a run: SHAKE256(seed || b), both little endian.
+_INLINE_ void dfr_batch_prng(OUT shake256_prng_state_t* prng,
+        IN const uint64_t seed,
+        IN const uint64_t b)
+{
+    uint8_t in[16];
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        in[i] = (uint8_t)(seed >> (8*i));
+        in[8 + i] = (uint8_t)(b >> (8*i));
+    }
+    memset(prng, 0, sizeof(*prng));
+    shake256_init(in, sizeof(in), prng);
+}
+
+// A new key in t->h0, t->h1.
+_INLINE_ void dfr_sample_key(IN OUT dfr_trial_t* t,
+        IN OUT shake256_prng_state_t* prng)
+{
+    sample_key_block(t->h0, t, prng);
+    sample_key_block(t->h1, t, prng);
+}
+
+// An error of the given weight in t->e_true and its syndrome in t->s.
+_INLINE_ void dfr_sample_error(IN OUT dfr_trial_t* t,
+        IN const uint32_t weight,
+        IN OUT shake256_prng_state_t* prng)
+{
+    sample_positions(t->e_pos, t->e_true, weight, N_BITS, prng);
+
+    memset(t->s_row, 0, R_BITS);
+    for (uint32_t k = 0; k < weight; k++)
+    {
+        const uint32_t in_e1 = (t->e_pos[k] >= R_BITS);
+        const uint32_t a = t->e_pos[k] - (in_e1 ? R_BITS : 0);
+        const uint32_t* h = in_e1 ? t->h1 : t->h0;
+        for (uint32_t i = 0; i < DV; i++)
+        {
+            const uint32_t j = a + h[i];
+            t->s_row[(j >= R_BITS) ? (j - R_BITS) : j] ^= 1;
+        }
+    }
+    transpose(t->s, t->s_row);
+}
+
+// Wilson score interval of k failures in n trials. The bound at 0 (k = 0)
+// or 1 (k = n) is exact: center - half would only leave rounding noise.
+_INLINE_ void dfr_wilson(IN const uint64_t k, IN const uint64_t n, OUT double* lo, OUT double* hi)
+{
+    const double p = (double)k / (double)n;
+    const double z2 = DFR_Z * DFR_Z;
+    const double denom = 1.0 + z2 / n;
+    const double center = (p + z2 / (2.0 * n)) / denom;
+    const double half = DFR_Z * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denom;
+
+    *lo = ((k > 0) && (center > half)) ? (center - half) : 0.0;
+    *hi = ((k < n) && (center + half < 1.0)) ? (center + half) : 1.0;
+}
+
+#endif //_DFR_TRIAL_H_
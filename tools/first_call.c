@@ -0,0 +1,292 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// First-call versus steady-state latency of the KEM API. Every trial is a
+// fresh child process (fork) in which nothing of the library is set up
+// yet: it times its first keygen, encaps and decaps, then the median of
+// -n more calls of each. The trials run twice per level, as is ("cold")
+// and after bike_init ("init", whose own time is reported as well). The
+// table has the medians over -t trials.
+//   bike-first-call [-l levels] [-t trials] [-n steady calls]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <chrono>
+
+#include "levels/bike_kem.h"
+
+#define FIRST_DEFAULT_TRIALS 15U
+#define FIRST_DEFAULT_STEADY 50U
+#define FIRST_MAX_TRIALS 1000U
+
+typedef enum
+{
+    OP_KEYGEN = 0,
+    OP_ENCAPS,
+    OP_DECAPS,
+    OP_COUNT
+} first_op_t;
+
+static const char* const op_names[OP_COUNT] = {"keygen", "encaps", "decaps"};
+
+// What one child reports, in ns.
+typedef struct first_sample_s
+{
+    double init_ns;
+    double first_ns[OP_COUNT];
+    double steady_ns[OP_COUNT];
+} first_sample_t;
+
+typedef std::chrono::steady_clock clk;
+
+static double elapsed_ns(const clk::time_point t0)
+{
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now() - t0).count();
+}
+
+static double median(double* v, const uint32_t n)
+{
+    std::sort(v, v + n);
+    return (n % 2) ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+// One call of op; keygen refreshes the pk/sk used by the others.
+static int first_call(const bike_kem_t* kem, const first_op_t op,
+        unsigned char* pk, unsigned char* sk, unsigned char* ct, unsigned char* ss)
+{
+    switch (op)
+    {
+    case OP_KEYGEN: return kem->keypair(pk, sk);
+    case OP_ENCAPS: return kem->enc(ct, ss, pk);
+    default:        return kem->dec(ss, ct, sk);
+    }
+}
+
+// The body of a trial, in the child.
+static int first_trial(first_sample_t* s, const bike_kem_t* kem, const int init,
+        const uint32_t steady)
+{
+    unsigned char* pk = (unsigned char*)malloc(kem->pk_bytes);
+    unsigned char* sk = (unsigned char*)malloc(kem->sk_bytes);
+    unsigned char* ct = (unsigned char*)malloc(kem->ct_bytes);
+    unsigned char* ss = (unsigned char*)malloc(kem->ss_bytes);
+    double* ns = (double*)malloc(steady * sizeof(double));
+    int rc = (pk == NULL) || (sk == NULL) || (ct == NULL) || (ss == NULL) || (ns == NULL);
+
+    memset(s, 0, sizeof(*s));
+    if ((rc == 0) && init)
+    {
+        const clk::time_point t0 = clk::now();
+        rc |= kem->init();
+        s->init_ns = elapsed_ns(t0);
+    }
+    for (uint32_t op = 0; (rc == 0) && (op < OP_COUNT); op++)
+    {
+        const clk::time_point t0 = clk::now();
+        rc |= first_call(kem, (first_op_t)op, pk, sk, ct, ss);
+        s->first_ns[op] = elapsed_ns(t0);
+    }
+    for (uint32_t op = 0; (rc == 0) && (op < OP_COUNT); op++)
+    {
+        for (uint32_t i = 0; i < steady; i++)
+        {
+            const clk::time_point t0 = clk::now();
+            rc |= first_call(kem, (first_op_t)op, pk, sk, ct, ss);
+            ns[i] = elapsed_ns(t0);
+        }
+        s->steady_ns[op] = median(ns, steady);
+    }
+
+    free(pk);
+    free(sk);
+    free(ct);
+    free(ss);
+    free(ns);
+    return rc;
+}
+
+// Runs a trial in a fresh child and reads its sample from a pipe.
+static int first_fork(first_sample_t* s, const bike_kem_t* kem, const int init,
+        const uint32_t steady)
+{
+    int fd[2];
+    int status = 0;
+
+    if (pipe(fd) != 0)
+    {
+        return 1;
+    }
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(fd[0]);
+        close(fd[1]);
+        return 1;
+    }
+    if (pid == 0)
+    {
+        close(fd[0]);
+        int rc = first_trial(s, kem, init, steady);
+        rc |= (write(fd[1], s, sizeof(*s)) != (ssize_t)sizeof(*s));
+        _exit(rc);
+    }
+
+    close(fd[1]);
+    const ssize_t got = read(fd[0], s, sizeof(*s));
+    close(fd[0]);
+    waitpid(pid, &status, 0);
+    return (got != (ssize_t)sizeof(*s)) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0);
+}
+
+// Medians over the trials of one level and mode; prints a table row.
+static int first_run(const bike_kem_t* kem, const int init, const uint32_t trials,
+        const uint32_t steady)
+{
+    first_sample_t* s = (first_sample_t*)malloc(trials * sizeof(first_sample_t));
+    double* v = (double*)malloc(trials * sizeof(double));
+    int rc = (s == NULL) || (v == NULL);
+
+    for (uint32_t t = 0; (rc == 0) && (t < trials); t++)
+    {
+        rc |= first_fork(&s[t], kem, init, steady);
+    }
+    if (rc == 0)
+    {
+        for (uint32_t t = 0; t < trials; t++)
+        {
+            v[t] = s[t].init_ns;
+        }
+        const double init_ns = median(v, trials);
+        printf("%-5u %-5s", kem->level, init ? "init" : "cold");
+        if (init)
+        {
+            printf(" %10.1f", init_ns / 1000);
+        }
+        else
+        {
+            printf(" %10s", "-");
+        }
+        for (uint32_t op = 0; op < OP_COUNT; op++)
+        {
+            for (uint32_t t = 0; t < trials; t++)
+            {
+                v[t] = s[t].first_ns[op];
+            }
+            const double first_ns = median(v, trials);
+            for (uint32_t t = 0; t < trials; t++)
+            {
+                v[t] = s[t].steady_ns[op];
+            }
+            const double steady_ns = median(v, trials);
+            printf(" %10.1f %10.1f %6.2fx", first_ns / 1000, steady_ns / 1000, first_ns / steady_ns);
+        }
+        printf("\n");
+    }
+
+    free(s);
+    free(v);
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t levels[3];
+    uint32_t n_levels = 0;
+    const char* level_arg = "1";
+    long trials = FIRST_DEFAULT_TRIALS;
+    long steady = FIRST_DEFAULT_STEADY;
+    int ok = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "l:t:n:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'l': level_arg = optarg; break;
+        case 't': trials = atol(optarg); break;
+        case 'n': steady = atol(optarg); break;
+        default: ok = 0; break;
+        }
+    }
+
+    char levels_buf[32];
+    snprintf(levels_buf, sizeof(levels_buf), "%s", level_arg);
+    for (char* tok = strtok(levels_buf, ","); tok != NULL; tok = strtok(NULL, ","))
+    {
+        ok &= (n_levels < 3) && (bike_kem((uint32_t)atoi(tok)) != NULL);
+        if (ok)
+        {
+            levels[n_levels++] = (uint32_t)atoi(tok);
+        }
+    }
+
+    if (!ok || (n_levels == 0) || (optind != argc) || (trials < 1) ||
+        (trials > FIRST_MAX_TRIALS) || (steady < 1))
+    {
+        printf("usage: %s [-l levels] [-t trials] [-n steady calls]\n", argv[0]);
+        return 2;
+    }
+
+    printf("BIKE first call vs steady state, median of %ld fresh processes, "
+           "steady state = median of %ld calls (us)\n", trials, steady);
+    printf("%-5s %-5s %10s", "level", "mode", "bike_init");
+    for (uint32_t op = 0; op < OP_COUNT; op++)
+    {
+        printf(" %10s %10s %7s", op_names[op], "steady", "ratio");
+    }
+    printf("\n");
+
+    int rc = 0;
+    for (uint32_t l = 0; l < n_levels; l++)
+    {
+        for (int init = 0; init <= 1; init++)
+        {
+            if (first_run(bike_kem(levels[l]), init, (uint32_t)trials, (uint32_t)steady) != 0)
+            {
+                printf("level %u: %s trial failed\n", levels[l], init ? "init" : "cold");
+                rc = 1;
+            }
+        }
+    }
+
+    return rc;
+}
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// Generates threshold_tables.h: both threshold rules of the configured
+// level as run-length tables of the syndrome weight (0..R_BITS), evaluated
+// with the same double-precision expressions the decoder used at run time.
+// Built once per level by "make threshold-tables":
+//   gen_threshold_tables --begin | (per level) | gen_threshold_tables --end
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "types.h"
+#include "threshold.h"
+
+static uint32_t affine_threshold(uint32_t weight)
+{
+    return floor(VAR_TH_FCT(weight));
+}
+
+static uint32_t exact_threshold(uint32_t weight)
+{
+    return compute_threshold(R_BITS, N_BITS, DV, 2*DV, weight, T1);
+}
+
+static void print_table(const char* name, uint32_t (*rule)(uint32_t))
+{
+    uint32_t count = 0;
+    uint32_t prev = 0;
+
+    printf("static const threshold_run_t %s[] = {", name);
+    for (uint32_t weight = 0; weight <= R_BITS; weight++)
+    {
+        const uint32_t t = rule(weight);
+        if ((weight == 0) || (t != prev))
+        {
+            printf("%s{%u, %u}", (count % 6 == 0) ? "\n    " : " ", weight, t);
+            printf(",");
+            count++;
+            prev = t;
+        }
+    }
+    printf("\n};\n");
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "--begin") == 0))
+    {
+        printf("// Generated by tools/gen_threshold_tables.c (make threshold-tables).\n");
+        printf("// {first syndrome weight, threshold} runs of the BGF threshold rules.\n\n");
+        printf("#ifndef _THRESHOLD_TABLES_H_\n#define _THRESHOLD_TABLES_H_\n\n");
+        printf("#include \"types.h\"\n#include \"threshold.h\"\n");
+        return 0;
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "--end") == 0))
+    {
+        printf("\n#define THRESHOLD_RUNS(t) ((uint32_t)(sizeof(t) / sizeof(t[0])))\n");
+        printf("\n#endif //_THRESHOLD_TABLES_H_\n");
+        return 0;
+    }
+
+#if defined(PARAM128)
+    const char* level = "PARAM128";
+#elif defined(PARAM96)
+    const char* level = "PARAM96";
+#else
+    const char* level = "PARAM64";
+#endif
+
+    printf("\n// r = %u, d = %u, t = %u\n", (uint32_t)R_BITS, (uint32_t)DV, (uint32_t)T1);
+    printf("#if defined(%s)\n", level);
+    print_table("threshold_affine_runs", affine_threshold);
+    print_table("threshold_exact_runs", exact_threshold);
+    printf("#endif\n");
+
+    return 0;
+}
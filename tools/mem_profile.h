@@ -0,0 +1,224 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+// Peak memory of a call: the high-water mark of the stack it runs on, the
+// peak of the heap bytes in use above the level at its start, and the
+// number of allocations it makes. The call runs on a fresh thread whose
+// stack was painted beforehand, and the malloc family is replaced by
+// wrappers of the glibc allocator (this covers new, NTL, OpenSSL and the
+// workspaces). Include in one translation unit of a test or tool.
+
+#ifndef _MEM_PROFILE_H_
+#define _MEM_PROFILE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+
+#define MEM_PROFILE_STACK (4ULL << 20)
+#define MEM_PROFILE_PAINT 0x5A
+
+typedef struct mem_usage_s
+{
+    size_t stack;
+    size_t heap;
+    size_t allocs;
+} mem_usage_t;
+
+////////////////////////////////////////////////////////////////
+//   Heap accounting
+////////////////////////////////////////////////////////////////
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* p);
+
+static size_t g_heap_cur = 0;
+static size_t g_heap_peak = 0;
+static size_t g_heap_allocs = 0;
+
+static void heap_add(void* p)
+{
+    if (p == NULL)
+    {
+        return;
+    }
+
+    __atomic_add_fetch(&g_heap_allocs, 1, __ATOMIC_RELAXED);
+    const size_t cur = __atomic_add_fetch(&g_heap_cur, malloc_usable_size(p), __ATOMIC_RELAXED);
+    size_t peak = __atomic_load_n(&g_heap_peak, __ATOMIC_RELAXED);
+    while ((cur > peak) &&
+           !__atomic_compare_exchange_n(&g_heap_peak, &peak, cur, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+static void heap_sub(void* p)
+{
+    if (p != NULL)
+    {
+        __atomic_sub_fetch(&g_heap_cur, malloc_usable_size(p), __ATOMIC_RELAXED);
+    }
+}
+
+void* malloc(size_t size) __THROW
+{
+    void* p = __libc_malloc(size);
+    heap_add(p);
+    return p;
+}
+
+void* calloc(size_t n, size_t size) __THROW
+{
+    void* p = __libc_calloc(n, size);
+    heap_add(p);
+    return p;
+}
+
+void* realloc(void* old, size_t size) __THROW
+{
+    const size_t old_size = (old != NULL) ? malloc_usable_size(old) : 0;
+    void* p = __libc_realloc(old, size);
+    if ((p != NULL) || (size == 0))
+    {
+        __atomic_sub_fetch(&g_heap_cur, old_size, __ATOMIC_RELAXED);
+        heap_add(p);
+    }
+    return p;
+}
+
+void* memalign(size_t alignment, size_t size) __THROW
+{
+    void* p = __libc_memalign(alignment, size);
+    heap_add(p);
+    return p;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) __THROW
+{
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) __THROW
+{
+    void* p = memalign(alignment, size);
+    if (p == NULL)
+    {
+        return ENOMEM;
+    }
+    *out = p;
+    return 0;
+}
+
+void free(void* p) __THROW
+{
+    heap_sub(p);
+    __libc_free(p);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+////////////////////////////////////////////////////////////////
+//   Stack accounting
+////////////////////////////////////////////////////////////////
+
+// Runs fn(arg) on a painted stack of its own; returns what fn returns (as
+// an int), or -1 if the thread cannot be started.
+static int mem_profile_run(void* (*fn)(void*), void* arg, mem_usage_t* usage)
+{
+    unsigned char* stack = (unsigned char*)__libc_memalign(4096, MEM_PROFILE_STACK);
+    pthread_attr_t attr;
+    pthread_t thread;
+    void* rc = NULL;
+
+    memset(usage, 0, sizeof(*usage));
+    if (stack == NULL)
+    {
+        return -1;
+    }
+    memset(stack, MEM_PROFILE_PAINT, MEM_PROFILE_STACK);
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, MEM_PROFILE_STACK);
+
+    const size_t heap_base = __atomic_load_n(&g_heap_cur, __ATOMIC_RELAXED);
+    const size_t allocs_base = __atomic_load_n(&g_heap_allocs, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_heap_peak, heap_base, __ATOMIC_RELAXED);
+
+    const int started = (pthread_create(&thread, &attr, fn, arg) == 0);
+    if (started)
+    {
+        pthread_join(thread, &rc);
+    }
+
+    // the stack grows down from the top of the block
+    size_t untouched = 0;
+    while ((untouched < MEM_PROFILE_STACK) && (stack[untouched] == MEM_PROFILE_PAINT))
+    {
+        untouched++;
+    }
+
+    usage->stack = MEM_PROFILE_STACK - untouched;
+    usage->heap = __atomic_load_n(&g_heap_peak, __ATOMIC_RELAXED) - heap_base;
+    usage->allocs = __atomic_load_n(&g_heap_allocs, __ATOMIC_RELAXED) - allocs_base;
+
+    pthread_attr_destroy(&attr);
+    __libc_free(stack);
+
+    return started ? (int)(intptr_t)rc : -1;
+}
+
+// usage -= base (an empty thread), and then peak = max(peak, usage).
+static void mem_usage_peak(mem_usage_t* peak, mem_usage_t usage, const mem_usage_t* base)
+{
+    usage.stack -= (usage.stack > base->stack) ? base->stack : usage.stack;
+    usage.heap -= (usage.heap > base->heap) ? base->heap : usage.heap;
+    usage.allocs -= (usage.allocs > base->allocs) ? base->allocs : usage.allocs;
+    peak->stack = (usage.stack > peak->stack) ? usage.stack : peak->stack;
+    peak->heap = (usage.heap > peak->heap) ? usage.heap : peak->heap;
+    peak->allocs = (usage.allocs > peak->allocs) ? usage.allocs : peak->allocs;
+}
+
+#endif //_MEM_PROFILE_H_
@@ -42,27 +42,6 @@
 #include <stdint.h>
 #include <stddef.h>
 
-/* type definitions used in backflip decoder: */
-typedef uint8_t bit_t;
-typedef uint16_t index_t;
-typedef struct ring_buffer *ring_buffer_t;
-typedef struct parameters *parameters_t;
-typedef struct decoder *decoder_t;
-
-/* Implement the backflip flipping queue as a ring buffer */
-struct ring_buffer {
-    index_t *raw_ptr_index;
-    index_t *start_ptr_index;
-    index_t *raw_ptr_position;
-    index_t *start_ptr_position;
-    /* Extra information on a position that might be useful */
-    int *raw_ptr_extra;
-    int *start_ptr_extra;
-    size_t size;
-    size_t start_idx;
-    size_t length;
-};
-
 typedef struct uint128_s
 {
     union
@@ -191,7 +170,9 @@ enum _status
     E_AES_CTR_PRF_INIT_FAIL          = 9,
     E_AES_OVER_USED                  = 10,
     E_SHA384_FAIL                    = 11,
-    E_SHAKE128_FAIL                  = 12
+    E_SHAKE128_FAIL                  = 12,
+    E_ALLOCATION_FAILURE             = 13,
+    E_POOL_STOPPED                   = 14
 };
 
 typedef enum _status status_t;
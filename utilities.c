@@ -38,6 +38,10 @@
 #include "utilities.h"
 #include "stdio.h"
 #include "openssl_utils.h"
+#include <time.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
 
 #define BITS_IN_QW 64ULL
 #define BITS_IN_BYTE 8ULL
@@ -175,3 +179,17 @@ void print_BE(IN const uint64_t *in, IN const uint32_t bits_num)
     printf("\n");
 }
 
+uint64_t bike_ticks(void)
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
@@ -60,6 +60,11 @@ void print_BE(IN const uint64_t *in, IN const uint32_t bits_num);
 #define print(in, bits_num)
 #endif
 
+//Time stamp of the instrumentation (decoder trace, stage timing): the TSC
+//on x86-64, the virtual counter on AArch64, nanoseconds of CLOCK_MONOTONIC
+//elsewhere.
+uint64_t bike_ticks(void);
+
 //Comparing value in a constant time manner.
 _INLINE_ uint32_t safe_cmp(IN const uint8_t* a,
         IN const uint8_t* b,
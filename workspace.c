@@ -0,0 +1,154 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "workspace.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+size_t bike_ws_size(void)
+{
+    return sizeof(bike_ws_t);
+}
+
+bike_ws_t* bike_ws_init(IN void* mem, IN const size_t size)
+{
+    if ((mem == NULL) || (((uintptr_t)mem % BIKE_WS_ALIGN) != 0) ||
+        (size < sizeof(bike_ws_t)))
+    {
+        return NULL;
+    }
+
+    bike_ws_t* ws = (bike_ws_t*)mem;
+#ifndef BIKE_LOW_MEM
+    ws->fq = NULL;
+#endif
+
+    return ws;
+}
+
+void bike_ws_fini(IN bike_ws_t* ws)
+{
+#ifndef BIKE_LOW_MEM
+    if (ws != NULL)
+    {
+        fq_free(ws->fq);
+        ws->fq = NULL;
+    }
+#else
+    (void)ws;
+#endif
+}
+
+bike_ws_t* bike_ws_alloc(void)
+{
+    void* mem = NULL;
+    if (posix_memalign(&mem, BIKE_WS_ALIGN, sizeof(bike_ws_t)) != 0)
+    {
+        return NULL;
+    }
+
+    return bike_ws_init(mem, sizeof(bike_ws_t));
+}
+
+void bike_ws_free(IN bike_ws_t* ws)
+{
+    bike_ws_fini(ws);
+    free(ws);
+}
+
+// The thread workspaces hang off a key whose destructor frees them. The
+// destructor does not run for the main thread, so exit() frees the
+// workspace of the thread that calls it.
+static pthread_key_t g_ws_key;
+static pthread_once_t g_ws_once = PTHREAD_ONCE_INIT;
+static int g_ws_key_ok = 0;
+
+static void ws_key_destroy(IN void* ws)
+{
+    bike_ws_free((bike_ws_t*)ws);
+}
+
+static void ws_key_create(void)
+{
+    g_ws_key_ok = (pthread_key_create(&g_ws_key, ws_key_destroy) == 0);
+    if (g_ws_key_ok)
+    {
+        atexit(bike_ws_thread_free);
+    }
+}
+
+bike_ws_t* bike_ws_thread(void)
+{
+    pthread_once(&g_ws_once, ws_key_create);
+    if (!g_ws_key_ok)
+    {
+        return NULL;
+    }
+
+    bike_ws_t* ws = (bike_ws_t*)pthread_getspecific(g_ws_key);
+    if (ws != NULL)
+    {
+        return ws;
+    }
+
+    ws = bike_ws_alloc();
+    if ((ws != NULL) && (pthread_setspecific(g_ws_key, ws) != 0))
+    {
+        bike_ws_free(ws);
+        ws = NULL;
+    }
+
+    return ws;
+}
+
+void bike_ws_thread_free(void)
+{
+    pthread_once(&g_ws_once, ws_key_create);
+    if (!g_ws_key_ok)
+    {
+        return;
+    }
+
+    bike_ws_t* ws = (bike_ws_t*)pthread_getspecific(g_ws_key);
+    if (ws != NULL)
+    {
+        pthread_setspecific(g_ws_key, NULL);
+        bike_ws_free(ws);
+    }
+}
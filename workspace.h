@@ -0,0 +1,144 @@
+/******************************************************************************
+ * BIKE -- Bit Flipping Key Encapsulation
+ *
+ * Copyright (c) 2021 Nir Drucker, Shay Gueron, Rafael Misoczki, Tobias Oder,
+ * Tim Gueneysu, Jan Richter-Brockmann.
+ * Contact: drucker.nir@gmail.com, shay.gueron@gmail.com,
+ * rafaelmisoczki@google.com, tobias.oder@rub.de, tim.gueneysu@rub.de,
+ * jan.richter-brockmann@rub.de.
+ *
+ * Permission to use this code for BIKE is granted.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * The names of the contributors may not be used to endorse or promote
+ *   products derived from this software without specific prior written
+ *   permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ""AS IS"" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHORS CORPORATION OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef _WORKSPACE_H_
+#define _WORKSPACE_H_
+
+#include "types.h"
+#include "gf2x.h"
+#include "decode_kernels.h"
+#include "flip_queue.h"
+
+#include <stddef.h>
+
+// Workspace arena of the decoders and of decapsulation. Every temporary
+// that scales with R_BITS lives here instead of on the stack (at level 5
+// they add up to several hundred KB), so the _ws entry points run on small
+// thread stacks. A workspace is allocated once and reused by any number of
+// successive calls, but is used by one call at a time.
+//
+// The entry points without _ws use the calling thread's workspace
+// (bike_ws_thread), allocated on first use and freed at thread exit. The
+// main thread's one is freed by exit() (thread-key destructors do not run
+// for it), or earlier by bike_ws_thread_free.
+
+#define BIKE_WS_ALIGN 64ULL
+
+#define WS_ALIGNED __attribute__((aligned(BIKE_WS_ALIGN)))
+
+#ifdef BIKE_LOW_MEM
+
+// Bit-packed, and the phases of a decapsulation share the same memory.
+typedef struct bike_ws_s
+{
+    // syndrome c0*h0 and decoded error e0 || e1, live through decaps
+    uint64_t s[R_QWORDS] WS_ALIGNED;
+    uint8_t e_prime[N_SIZE] WS_ALIGNED;
+
+    union
+    {
+        // compute_syndrome: c0 reduced mod x^R_BITS - 1
+        uint64_t c0[R_QWORDS] WS_ALIGNED;
+        // BGF: black and gray marks, one bit per position of e
+        struct
+        {
+            uint8_t black[N_SIZE];
+            uint8_t gray[N_SIZE];
+        };
+        // functionL and functionH
+        struct
+        {
+            uint8_t e_split[2*R_SIZE];
+            uint8_t e_recomputed[N_SIZE];
+        };
+        // functionK: m || c0 || c1
+        uint8_t mc0c1[2*ELL_SIZE + R_SIZE];
+    };
+} bike_ws_t;
+
+#else
+
+typedef struct bike_ws_s
+{
+    // decoders (BGF and Backflip)
+    uint8_t s_dup[S_DUP_SIZE] WS_ALIGNED;
+    uint8_t upc[R_PADDED_BITS] WS_ALIGNED;
+    uint8_t black[R_BITS*2] WS_ALIGNED;
+    uint8_t gray[R_BITS*2] WS_ALIGNED;
+    // flip marks of BFMaskedIter, times to live of Backflip
+    uint8_t pos[R_BITS*2] WS_ALIGNED;
+    // Backflip only: allocated by its first decode on this workspace
+    flip_queue_t* fq;
+
+    // decapsulation
+    syndrome_t syndrome WS_ALIGNED;
+    uint8_t s_bytes[R_BITS] WS_ALIGNED;
+    uint8_t s0[R_SIZE] WS_ALIGNED;
+    uint8_t e[R_BITS*2] WS_ALIGNED;
+    uint8_t e_prime[N_SIZE] WS_ALIGNED;
+    uint8_t e_recomputed[N_SIZE] WS_ALIGNED;
+    uint8_t e_split[2*R_SIZE] WS_ALIGNED;
+    uint8_t mc0c1[2*ELL_SIZE + R_SIZE] WS_ALIGNED;
+    gf2x_ws_t mul WS_ALIGNED;
+} bike_ws_t;
+
+#endif
+
+// Bytes a caller-provided workspace needs (aligned to BIKE_WS_ALIGN).
+size_t bike_ws_size(void);
+
+// Set up a workspace in caller memory. Returns NULL if mem is not aligned
+// to BIKE_WS_ALIGN or size < bike_ws_size().
+bike_ws_t* bike_ws_init(IN void* mem, IN const size_t size);
+
+// Free what the decoders allocated on first use (the flip queue of
+// Backflip). bike_ws_free does it; a bike_ws_init workspace needs it before
+// its memory is released.
+void bike_ws_fini(IN bike_ws_t* ws);
+
+// Heap workspace; bike_ws_alloc returns NULL if the allocation fails.
+bike_ws_t* bike_ws_alloc(void);
+void bike_ws_free(IN bike_ws_t* ws);
+
+// The calling thread's workspace, or NULL if it cannot be allocated.
+bike_ws_t* bike_ws_thread(void);
+
+// Free the calling thread's workspace now; the next bike_ws_thread call
+// allocates a new one.
+void bike_ws_thread_free(void);
+
+#endif //_WORKSPACE_H_